@@ -0,0 +1,60 @@
+#ifndef BARCODE_H
+#define BARCODE_H
+
+#include <bitmap_operation.h>
+#include <helper.h>
+
+// ============================================================================
+// 1D BARCODES
+// Encoders produce a Barcode: element widths in modules, alternating bar and
+// space and starting with a bar. Every bar is a full-height vertical run, so
+// drawing fills whole columns: one prepared row written to every row of a
+// row-major canvas, or whole column bytes on a printer-format canvas.
+// ============================================================================
+
+// Code 128 with up to 40 data symbols fits
+#define MAX_BARCODE_ELEMENTS 264
+
+struct Barcode {
+  uint8_t widths[MAX_BARCODE_ELEMENTS];
+  int count;      // elements in widths
+  int modules;    // symbol width in modules, quiet zones excluded
+  int quietLeft;  // blank modules required before the symbol
+  int quietRight; // blank modules required after it
+};
+
+// Code 128 for ASCII text (0x00-0x7F). Code sets A, B and C are chosen
+// automatically: C for runs of digits long enough to pay for the switch,
+// SHIFT for a single character from the other of A and B. Returns false for
+// empty, non-ASCII or over-long text.
+bool encodeCode128(Barcode &barcode, const char *text);
+
+// EAN-13 from 12 digits (the check digit is computed) or 13 (the check digit
+// is verified); returns false on anything else
+bool encodeEan13(Barcode &barcode, const char *digits);
+
+// UPC-A from 11 or 12 digits, encoded as EAN-13 with a leading 0
+bool encodeUpcA(Barcode &barcode, const char *digits);
+
+// Columns taken by the symbol and its quiet zones at a module width
+inline int barcodeWidth(const Barcode &barcode, int moduleWidth) {
+  return (barcode.quietLeft + barcode.modules + barcode.quietRight) *
+         moduleWidth;
+}
+
+// Largest module width (dots per module) at which the symbol and its quiet
+// zones fit in `width` columns; 0 if it does not fit at all
+inline int barcodeModuleWidth(const Barcode &barcode, int width) {
+  return width / barcodeWidth(barcode, 1);
+}
+
+// Draw the symbol with its left quiet zone starting at column x, over rows
+// [y1, y2). Bars are set and spaces and quiet zones cleared.
+template <int W, int H>
+void drawBarcode(BasicBitmap<W, H> &bitmap, const Barcode &barcode, int x,
+                 int y1, int y2, int moduleWidth);
+template <int W, int H>
+void drawBarcode(PrinterBitmap<W, H> &bitmap, const Barcode &barcode, int x,
+                 int y1, int y2, int moduleWidth);
+
+#endif // BARCODE_H
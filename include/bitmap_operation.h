@@ -4,45 +4,248 @@
 #include <functional>
 #include <helper.h>
 
+// All operations are templates over the canvas size and are explicitly
+// instantiated for every FOR_EACH_TAPE_BITMAP size in bitmap_operation.cpp.
+//
+// Drawing functions only touch pixels inside the canvas clip rectangle (see
+// ClipStack and pushClip() in helper.h), including fillBitmap/clearBitmap.
+// invertBitmap, copyBitmap, flipH and flipV always work on the whole canvas.
+
 // ============================================================================
 // BITMAP CREATION
 // ============================================================================
 
 // Create empty bitmap - returns pointer (caller must delete)
-Bitmap *createEmptyBitmapPtr();
+template <int W = IMAGE_WIDTH, int H = IMAGE_HEIGHT>
+BasicBitmap<W, H> *createEmptyBitmapPtr();
 
 // Stack-friendly versions (for small scope usage only)
-Bitmap createEmptyBitmap();
-Bitmap createFilledBitmap(bool black);
+template <int W = IMAGE_WIDTH, int H = IMAGE_HEIGHT>
+BasicBitmap<W, H> createEmptyBitmap();
+template <int W = IMAGE_WIDTH, int H = IMAGE_HEIGHT>
+BasicBitmap<W, H> createFilledBitmap(bool black);
 
 // ============================================================================
 // IN-PLACE OPERATIONS
 // ============================================================================
 
-void setPixel(Bitmap &bitmap, int x, int y, bool black);
-void clearPixel(Bitmap &bitmap, int x, int y);
-void fillBitmap(Bitmap &bitmap, bool black);
-void clearBitmap(Bitmap &bitmap);
-void mapPixels(Bitmap &bitmap, int x1, int y1, int x2, int y2,
+template <int W, int H>
+void setPixel(BasicBitmap<W, H> &bitmap, int x, int y, bool black);
+template <int W, int H>
+void clearPixel(BasicBitmap<W, H> &bitmap, int x, int y);
+template <int W, int H> void fillBitmap(BasicBitmap<W, H> &bitmap, bool black);
+template <int W, int H> void clearBitmap(BasicBitmap<W, H> &bitmap);
+// Fill the half-open horizontal run [x1, x2) on row y (clipped to the bitmap)
+template <int W, int H>
+void fillSpan(BasicBitmap<W, H> &bitmap, int y, int x1, int x2, bool black);
+// Set every pixel in [x1, x2) x [y1, y2) for which predicate(x, y) is true
+// (false leaves the pixel alone). Type-erased version; see below.
+template <int W, int H>
+void mapPixels(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2,
                std::function<bool(int, int)> predicate);
 
+// Same, with the predicate inlined: lambdas and functors resolve here. The
+// region is clipped once and each row is built a byte at a time, so there is
+// no per-pixel bounds check or read-modify-write.
+template <int W, int H, typename Predicate>
+inline void mapPixels(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2,
+                      int y2, Predicate predicate) {
+  const ClipRect &clip = bitmap.clip.rect;
+  if (x1 < clip.x1)
+    x1 = clip.x1;
+  if (y1 < clip.y1)
+    y1 = clip.y1;
+  if (x2 > clip.x2)
+    x2 = clip.x2;
+  if (y2 > clip.y2)
+    y2 = clip.y2;
+  if (x1 >= x2 || y1 >= y2) {
+    return;
+  }
+
+  markDirty(bitmap, x1, x2);
+
+  for (int y = y1; y < y2; y++) {
+    uint8_t *row = bitmapRow(bitmap, y);
+    uint8_t bits = 0;
+    for (int x = x1; x < x2; x++) {
+      if (predicate(x, y))
+        bits |= 0x80 >> (x & 7);
+      if ((x & 7) == 7 || x == x2 - 1) {
+        row[x >> 3] |= bits;
+        bits = 0;
+      }
+    }
+  }
+}
+
+// Span variant for procedural patterns. Each row is a sequence of runs that
+// alternate white (left alone) and black (filled), starting with white.
+// runLength(x, y, black) is called at the start of every run and returns its
+// length: 0 skips the run (e.g. to start a row black), a negative length ends
+// the row. A row must advance, so never return 0 for both colours at one x.
+template <int W, int H, typename RunLength>
+inline void mapSpans(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2,
+                     int y2, RunLength runLength) {
+  if (y1 < bitmap.clip.rect.y1)
+    y1 = bitmap.clip.rect.y1;
+  if (y2 > bitmap.clip.rect.y2)
+    y2 = bitmap.clip.rect.y2;
+
+  for (int y = y1; y < y2; y++) {
+    bool black = false;
+    for (int x = x1; x < x2;) {
+      const int length = runLength(x, y, black);
+      if (length < 0)
+        break;
+      const int end = (length < x2 - x) ? x + length : x2;
+      if (black)
+        fillSpan(bitmap, y, x, end, true);
+      x = end;
+      black = !black;
+    }
+  }
+}
+
 // Drawing functions
-void drawBorder(Bitmap &bitmap, int thickness);
-void drawDiagonals(Bitmap &bitmap);
-void drawChar(Bitmap &bitmap, char c, int startX, int startY);
-void drawString(Bitmap &bitmap, const char *str, int startX, int startY);
-void drawRect(Bitmap &bitmap, int x1, int y1, int x2, int y2);
-void fillRect(Bitmap &bitmap, int x1, int y1, int x2, int y2);
-void drawLine(Bitmap &bitmap, int x0, int y0, int x1, int y1);
-void drawCircle(Bitmap &bitmap, int centerX, int centerY, int radius);
-void fillCircle(Bitmap &bitmap, int centerX, int centerY, int radius);
-void invertBitmap(Bitmap &bitmap);
-void copyBitmap(Bitmap &dest, const Bitmap &src);
-void drawGrid(Bitmap &bitmap, int spacing);
-void drawCheckerboard(Bitmap &bitmap, int squareSize);
+template <int W, int H>
+void drawBorder(BasicBitmap<W, H> &bitmap, int thickness);
+template <int W, int H> void drawDiagonals(BasicBitmap<W, H> &bitmap);
+// Text in DEFAULT_FONT (font.h): drawChar takes a Latin-1 character,
+// drawString UTF-8. (startX, startY) is the top-left of the line box, which
+// includes the rows reserved for accents over capitals.
+template <int W, int H>
+void drawChar(BasicBitmap<W, H> &bitmap, char c, int startX, int startY);
+template <int W, int H>
+void drawString(BasicBitmap<W, H> &bitmap, const char *str, int startX,
+                int startY);
+template <int W, int H>
+void drawRect(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2);
+template <int W, int H>
+void fillRect(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2);
+template <int W, int H>
+void drawLine(BasicBitmap<W, H> &bitmap, int x0, int y0, int x1, int y1);
+template <int W, int H>
+void drawCircle(BasicBitmap<W, H> &bitmap, int centerX, int centerY,
+                int radius);
+template <int W, int H>
+void fillCircle(BasicBitmap<W, H> &bitmap, int centerX, int centerY,
+                int radius);
+template <int W, int H>
+void fillEllipse(BasicBitmap<W, H> &bitmap, int centerX, int centerY,
+                 int radiusX, int radiusY);
+// Pixels of the outerRadius disc that are not in the innerRadius disc
+template <int W, int H>
+void fillRing(BasicBitmap<W, H> &bitmap, int centerX, int centerY,
+              int innerRadius, int outerRadius);
+// Inclusive corners like fillRect, radius clamped to half the shorter side
+template <int W, int H>
+void fillRoundRect(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2,
+                   int radius);
+template <int W, int H> void invertBitmap(BasicBitmap<W, H> &bitmap);
+// Mirror left to right / top to bottom, in place
+template <int W, int H> void flipH(BasicBitmap<W, H> &bitmap);
+template <int W, int H> void flipV(BasicBitmap<W, H> &bitmap);
+template <int W, int H>
+void copyBitmap(BasicBitmap<W, H> &dest, const BasicBitmap<W, H> &src);
+template <int W, int H> void drawGrid(BasicBitmap<W, H> &bitmap, int spacing);
+template <int W, int H>
+void drawCheckerboard(BasicBitmap<W, H> &bitmap, int squareSize);
+
+// Raster operations for blit: how each source bit combines with the
+// destination bit (black = 1)
+enum RasterOp {
+  ROP_COPY,   // dest = src
+  ROP_OR,     // dest |= src (stamp black)
+  ROP_AND,    // dest &= src (mask)
+  ROP_XOR,    // dest ^= src (toggle)
+  ROP_ANDNOT, // dest &= ~src (erase where src is black)
+};
+
+// Combine the width x height block of src at (srcX, srcY) into dest at
+// (destX, destY). Clipped to both images; src must not overlap dest.
+template <int W, int H>
+void blit(BasicBitmap<W, H> &dest, int destX, int destY, const BitmapView &src,
+          int srcX, int srcY, int width, int height, RasterOp op);
+
+template <int W, int H, int SW, int SH>
+inline void blit(BasicBitmap<W, H> &dest, int destX, int destY,
+                 const BasicBitmap<SW, SH> &src, int srcX, int srcY,
+                 int width, int height, RasterOp op) {
+  blit(dest, destX, destY, bitmapView(src), srcX, srcY, width, height, op);
+}
+
+// Copy src turned clockwise by 90, 180 or 270 degrees, with the top-left of
+// the turned image at (destX, destY) (turned a quarter, src.width becomes
+// its height). Clipped; src must not overlap dest. Runs on 8x8 blocks, one
+// transposeBits8x8 per block for the quarter turns.
+template <int W, int H>
+void rotate90(BasicBitmap<W, H> &dest, int destX, int destY,
+              const BitmapView &src);
+template <int W, int H>
+void rotate180(BasicBitmap<W, H> &dest, int destX, int destY,
+               const BitmapView &src);
+template <int W, int H>
+void rotate270(BasicBitmap<W, H> &dest, int destX, int destY,
+               const BitmapView &src);
 
 // Composition
-void compose(Bitmap &bitmap, void (*f1)(Bitmap &), void (*f2)(Bitmap &),
-             void (*f3)(Bitmap &));
+template <int W, int H>
+void compose(BasicBitmap<W, H> &bitmap,
+             typename BasicBitmap<W, H>::Operation f1,
+             typename BasicBitmap<W, H>::Operation f2,
+             typename BasicBitmap<W, H>::Operation f3);
+
+// ============================================================================
+// PRINTER-FORMAT CANVAS (column-major, see PrinterBitmap in helper.h)
+// ============================================================================
+
+// Create empty printer-format bitmap - returns pointer (caller must delete)
+template <int W = IMAGE_WIDTH, int H = IMAGE_HEIGHT>
+PrinterBitmap<W, H> *createEmptyPrinterBitmapPtr();
+
+template <int W, int H>
+void setPixel(PrinterBitmap<W, H> &bitmap, int x, int y, bool black);
+template <int W, int H>
+void clearPixel(PrinterBitmap<W, H> &bitmap, int x, int y);
+template <int W, int H>
+void fillBitmap(PrinterBitmap<W, H> &bitmap, bool black);
+template <int W, int H> void clearBitmap(PrinterBitmap<W, H> &bitmap);
+// Fill the half-open horizontal run [x1, x2) on row y (one bit per column)
+template <int W, int H>
+void fillSpan(PrinterBitmap<W, H> &bitmap, int y, int x1, int x2, bool black);
+// Fill the half-open vertical run [y1, y2) in column x (whole 16-bit words)
+template <int W, int H>
+void fillColumnSpan(PrinterBitmap<W, H> &bitmap, int x, int y1, int y2,
+                    bool black);
+template <int W, int H>
+void fillRect(PrinterBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2);
+// OR `count` MSB-first packed bits (top row first) into one raw
+// printer-format column from row y, writing only rows [y1, y2). For column
+// buffers outside a canvas (e.g. a compression chunk); no dirty tracking.
+void orColumnBits(uint8_t *column, int y, const uint8_t *bits, int count,
+                  int y1, int y2);
+// OR `count` MSB-first packed bits (top row first) into column x from row y
+template <int W, int H>
+void blitColumnBits(PrinterBitmap<W, H> &dest, int x, int y,
+                    const uint8_t *bits, int count);
+// OR columns [srcX, srcX + width) of src into dest at (destX, destY)
+template <int W, int H>
+void blitColumns(PrinterBitmap<W, H> &dest, int destX, int destY,
+                 const PrinterBitmap<W, H> &src, int srcX, int width);
+// Mirror in place, e.g. after transformToPrinterFormat: flipH swaps whole
+// columns, flipV reverses each column's bits
+template <int W, int H> void flipH(PrinterBitmap<W, H> &bitmap);
+template <int W, int H> void flipV(PrinterBitmap<W, H> &bitmap);
+// Same as the BasicBitmap rotations
+template <int W, int H>
+void rotate90(PrinterBitmap<W, H> &dest, int destX, int destY,
+              const BitmapView &src);
+template <int W, int H>
+void rotate180(PrinterBitmap<W, H> &dest, int destX, int destY,
+               const BitmapView &src);
+template <int W, int H>
+void rotate270(PrinterBitmap<W, H> &dest, int destX, int destY,
+               const BitmapView &src);
 
 #endif // !BITMAP_OPERATION_H
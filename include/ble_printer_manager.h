@@ -20,8 +20,11 @@ void sendFrameBatch(int startIndex);
 // Start printing the prepared frames
 bool startPrintJob();
 
-// High-level: Prepare and print in one call
-bool printBitmap(const Bitmap &userBitmap);
+// High-level: Prepare and print in one call (any FOR_EACH_TAPE_BITMAP size)
+template <int W, int H> bool printBitmap(const BasicBitmap<W, H> &userBitmap);
+template <int W, int H>
+bool printBitmap(const PrinterBitmap<W, H> &userBitmap);
+template <int W, int H> bool printBitmap(const TextLabel<W, H> &label);
 
 // ============================================================================
 // STATUS QUERIES
@@ -0,0 +1,72 @@
+#ifndef DITHER_H
+#define DITHER_H
+
+#include <bitmap_operation.h>
+#include <helper.h>
+
+// ============================================================================
+// DITHERING
+// 8-bit grayscale (0 black, 255 white) to 1-bit, one source row at a time.
+// Error diffusion keeps only the error of the rows still to come, in 12.4
+// fixed point, and each finished row goes straight into the canvas as packed
+// bits, so a photo never needs an 8-bit frame buffer.
+//
+// Ordered dithering compares each pixel with a fixed threshold tiled from the
+// canvas origin, a whole output byte (8 pixels) per step. It is several times
+// faster, and its repeating pattern compresses far better than diffusion
+// noise, at the cost of a visible grid.
+// ============================================================================
+
+// Widest image row a Ditherer accepts
+#define MAX_DITHER_WIDTH IMAGE_WIDTH
+
+enum DitherMethod {
+  DITHER_FLOYD_STEINBERG, // 7/16 right, 3/16 5/16 1/16 below
+  DITHER_ATKINSON,        // 1/8 to six neighbours, 1/4 dropped (crisper)
+  DITHER_SIERRA_LITE,     // 2/4 right, 1/4 1/4 below (cheapest diffusion)
+  DITHER_BAYER_4X4,       // ordered, 17 gray levels
+  DITHER_BAYER_8X8,       // ordered, 65 gray levels
+  DITHER_THRESHOLD,       // dark below 128, for line art
+};
+
+// Streaming state. Two error rows for Floyd-Steinberg and Sierra Lite;
+// Atkinson reaches two rows down and uses the third. Ordered methods use
+// none.
+struct Ditherer {
+  DitherMethod method;
+  int x; // canvas position of the next row
+  int y;
+  int width;
+  int errorRows;
+  int current;
+  // One column of padding on the left and two on the right, so the kernels
+  // never test for the row ends
+  int16_t error[3][MAX_DITHER_WIDTH + 3];
+  uint8_t bits[MAX_DITHER_WIDTH / 8 + 2]; // the row, aligned to canvas bytes
+};
+
+// Start an image `width` pixels wide whose top-left pixel lands at (x, y).
+// Returns false if width is not 1..MAX_DITHER_WIDTH.
+bool startDither(Ditherer &ditherer, DitherMethod method, int x, int y,
+                 int width);
+
+// Dither the next row (ditherer.width pixels) and write it at ditherer.y,
+// dark pixels set and light pixels cleared. Rows outside the clip are still
+// diffused so the rows below them come out right.
+template <int W, int H>
+void ditherRow(BasicBitmap<W, H> &bitmap, Ditherer &ditherer,
+               const uint8_t *gray);
+template <int W, int H>
+void ditherRow(PrinterBitmap<W, H> &bitmap, Ditherer &ditherer,
+               const uint8_t *gray);
+
+// Whole image already in memory, rows `stride` bytes apart. Returns false if
+// the width is out of range.
+template <int W, int H>
+bool ditherImage(BasicBitmap<W, H> &bitmap, const uint8_t *gray, int width,
+                 int height, int stride, int x, int y, DitherMethod method);
+template <int W, int H>
+bool ditherImage(PrinterBitmap<W, H> &bitmap, const uint8_t *gray, int width,
+                 int height, int stride, int x, int y, DitherMethod method);
+
+#endif // DITHER_H
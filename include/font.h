@@ -0,0 +1,308 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include <bitmap_operation.h>
+#include <helper.h>
+#include <cstring>
+
+// ============================================================================
+// PROPORTIONAL BITMAP FONTS
+// Glyph images live in one packed atlas: each glyph is its trimmed bounding
+// box, rows MSB-first and padded to a whole byte, so a glyph is a BitmapView
+// and is drawn with one blit (shift-and-OR per row byte).
+//
+// Fonts are compiled from fonts/*.txt or BDF files by tools/fontc.py into
+// constexpr tables in include/fonts/, optionally subset to the glyphs a
+// build uses.
+//
+// Large fonts (CJK) can instead be compiled packed: glyph rows are
+// LZSS-compressed in blocks of FONT_BLOCK_GLYPHS and unpacked on demand into
+// a fixed LRU cache of GLYPH_CACHE_SLOTS rasterized glyphs.
+// ============================================================================
+
+// Glyphs per compressed block of a packed font (tools/fontc.py must match)
+#define FONT_BLOCK_GLYPHS 16
+
+// Largest row image, and largest column image, of a packed font's glyph
+// (32x32 pixels; tools/fontc.py must match)
+#define MAX_PACKED_GLYPH_BYTES 128
+
+// Rasterized glyphs of packed fonts kept in RAM
+#define GLYPH_CACHE_SLOTS 32
+
+struct Glyph {
+  uint16_t offset;  // first byte of the glyph image in Font::bitmaps (packed
+                    // fonts: in its unpacked block)
+  uint16_t columns; // first byte of the glyph columns in Font::columns
+  uint8_t width;    // image columns (0 for blank glyphs such as space)
+  uint8_t height;   // image rows
+  int8_t left;      // image x relative to the pen position
+  int8_t top;       // image y relative to the top of the line box
+  uint8_t advance;  // pen movement after the glyph
+};
+
+// Code points [first, first + count) map to glyphs[glyph .. glyph + count)
+struct FontRange {
+  uint16_t first;
+  uint16_t count;
+  uint16_t glyph;
+};
+
+struct Font {
+  const uint8_t *bitmaps; // glyph rows, or nullptr for packed fonts
+  const uint8_t *columns; // printer-format glyph columns, or nullptr
+  const uint8_t *packed;  // compressed blocks of glyph rows, or nullptr
+  const uint32_t *blocks; // start of each block in packed, plus the end
+  const Glyph *glyphs;
+  const FontRange *ranges;
+  uint8_t rangeCount;
+  uint8_t height;    // line box rows (accents, capitals, descenders)
+  uint8_t ascent;    // rows from the top of the line box to the baseline
+  uint16_t fallback; // glyph index drawn for missing code points
+};
+
+// 5x7 sans, ASCII and Latin-1 (fonts/font_5x7.txt)
+extern const Font FONT_5X7;
+
+// Font used by drawChar/drawString
+#define DEFAULT_FONT FONT_5X7
+
+// Glyph for a code point, or the font's fallback glyph
+const Glyph &findGlyph(const Font &font, uint32_t codepoint);
+
+// Next code point of a NUL-terminated UTF-8 string; str is advanced past it.
+// A byte that does not start a valid sequence is taken as Latin-1, so
+// Latin-1 strings still render.
+inline uint32_t nextCodepoint(const char *&str) {
+  const uint8_t *s = (const uint8_t *)str;
+  uint32_t cp = s[0];
+  int extra = 0;
+  uint32_t min = 0;
+  if (cp >= 0xC2 && cp < 0xE0) {
+    extra = 1;
+    cp &= 0x1F;
+    min = 0x80;
+  } else if (cp >= 0xE0 && cp < 0xF0) {
+    extra = 2;
+    cp &= 0x0F;
+    min = 0x800;
+  } else if (cp >= 0xF0 && cp < 0xF5) {
+    extra = 3;
+    cp &= 0x07;
+    min = 0x10000;
+  }
+
+  for (int i = 1; i <= extra; i++) {
+    if ((s[i] & 0xC0) != 0x80) {
+      str++;
+      return s[0];
+    }
+    cp = (cp << 6) | (s[i] & 0x3F);
+  }
+  if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp < 0xE000)) {
+    str++;
+    return s[0];
+  }
+  str += 1 + extra;
+  return cp;
+}
+
+// The glyph's rows ((glyph.width + 7) / 8 bytes each), or nullptr if a packed
+// font's glyph cannot be unpacked. A packed glyph stays valid only until the
+// next glyph lookup.
+const uint8_t *glyphRows(const Font &font, const Glyph &glyph);
+
+inline BitmapView glyphView(const Font &font, const Glyph &glyph) {
+  BitmapView view = {glyphRows(font, glyph), glyph.width, glyph.height,
+                     (glyph.width + 7) >> 3};
+  return view;
+}
+
+struct GlyphCacheStats {
+  uint32_t hits;
+  uint32_t misses; // each one unpacks a block unless it is the last unpacked
+};
+
+// Lookups of packed-font glyphs since start or the last reset
+GlyphCacheStats glyphCacheStats();
+void resetGlyphCacheStats();
+
+// Draw one glyph with the top-left of its line box at (x, y); returns the
+// advance. Glyphs are ORed in, so text can be drawn over other content.
+template <int W, int H>
+int drawGlyph(BasicBitmap<W, H> &bitmap, const Font &font, uint32_t codepoint,
+              int x, int y);
+
+// Draw a UTF-8 string on one line starting at (x, y); returns the pen x after
+// the last glyph.
+template <int W, int H>
+int drawText(BasicBitmap<W, H> &bitmap, const Font &font, const char *str,
+             int x, int y);
+
+// Pen advance of a UTF-8 string
+int textAdvance(const Font &font, const char *str);
+
+// ============================================================================
+// PRINTER-FORMAT TEXT
+// A glyph column is its `height` bits from the top image row down, MSB-first,
+// padded to whole bytes. Compiled fonts carry them in Font::columns; fonts
+// without are rotated once at runtime and cached. Text is then ORed into
+// printer-format columns a glyph column at a time, with no row-major canvas
+// and no transform pass.
+// ============================================================================
+
+// Fonts without compiled columns whose rotated glyphs can be cached at once
+#define MAX_COLUMN_FONTS 4
+
+// The glyph's columns (glyph.width of them, (glyph.height + 7) / 8 bytes
+// each), or nullptr if they must be cached and the cache cannot be built.
+// Packed fonts rasterize columns along with rows in the LRU glyph cache.
+const uint8_t *glyphColumns(const Font &font, const Glyph &glyph);
+
+// Printer-format columns [x1, x2) of a canvas, column x at
+// data + (x - x1) * bytesPerColumn; only rows [y1, y2) are written
+struct ColumnWindow {
+  uint8_t *data;
+  int x1;
+  int x2;
+  int y1;
+  int y2;
+  int bytesPerColumn;
+};
+
+// Draw a UTF-8 string into a window (top-left of its line box at (x, y));
+// returns the pen x after the last glyph. No dirty tracking.
+int drawTextColumns(const ColumnWindow &window, const Font &font,
+                    const char *str, int x, int y);
+
+// Same as the row-major versions, for printer-format canvases
+template <int W, int H>
+int drawGlyph(PrinterBitmap<W, H> &bitmap, const Font &font,
+              uint32_t codepoint, int x, int y);
+template <int W, int H>
+int drawText(PrinterBitmap<W, H> &bitmap, const Font &font, const char *str,
+             int x, int y);
+
+// ============================================================================
+// SCALED TEXT
+// Each glyph pixel becomes a scale x scale block. Glyph rows are drawn as
+// horizontal spans, one per run of set pixels per output row. Advances and
+// positions relative to (x, y) scale with the glyphs.
+// ============================================================================
+
+template <int W, int H>
+int drawGlyphScaled(BasicBitmap<W, H> &bitmap, const Font &font,
+                    uint32_t codepoint, int x, int y, int scale);
+template <int W, int H>
+int drawTextScaled(BasicBitmap<W, H> &bitmap, const Font &font,
+                   const char *str, int x, int y, int scale);
+template <int W, int H>
+int drawGlyphScaled(PrinterBitmap<W, H> &bitmap, const Font &font,
+                    uint32_t codepoint, int x, int y, int scale);
+template <int W, int H>
+int drawTextScaled(PrinterBitmap<W, H> &bitmap, const Font &font,
+                   const char *str, int x, int y, int scale);
+
+// ============================================================================
+// TEXT-ONLY LABELS
+// A label made only of text needs no canvas at all: compressAndGenerateFrames
+// renders each chunk's glyph columns straight into the compression buffer.
+// ============================================================================
+
+#define MAX_TEXT_RUNS 8
+// Longest run text in bytes (UTF-8), not counting the terminator
+#define MAX_TEXT_RUN_LENGTH 63
+
+// One line of text. The string is copied, so the caller's buffer can change
+// freely; use setText to change what the label prints.
+struct TextRun {
+  const Font *font;
+  char text[MAX_TEXT_RUN_LENGTH + 1];
+  int x;
+  int y;
+  int inkX1; // columns [inkX1, inkX2) the text covers, clipped to the label
+  int inkX2;
+};
+
+template <int Width, int Height>
+struct TextLabel : CanvasGeometry<Width, Height> {
+  TextRun runs[MAX_TEXT_RUNS];
+  int runCount;
+  mutable DirtyColumns dirty;
+
+  TextLabel() : runCount(0) {}
+};
+
+typedef TextLabel<IMAGE_WIDTH, TAPE_9MM_HEIGHT> TextLabel9mm;
+typedef TextLabel<IMAGE_WIDTH, TAPE_12MM_HEIGHT> TextLabel12mm;
+typedef TextLabel<IMAGE_WIDTH, TAPE_16MM_HEIGHT> TextLabel16mm;
+
+// Columns [x1, x2) a string's glyph images cover when drawn at pen x
+void textInkColumns(const Font &font, const char *str, int x, int &x1,
+                    int &x2);
+
+// Copy text into a run and mark the columns it covers dirty; false (run
+// untouched) if the text is longer than MAX_TEXT_RUN_LENGTH
+template <int W, int H>
+inline bool writeTextRun(TextLabel<W, H> &label, TextRun &run,
+                         const char *text) {
+  const size_t length = strlen(text);
+  if (length > MAX_TEXT_RUN_LENGTH) {
+    return false;
+  }
+  memcpy(run.text, text, length + 1);
+
+  int x1, x2;
+  textInkColumns(*run.font, run.text, run.x, x1, x2);
+  run.inkX1 = x1 < 0 ? 0 : x1;
+  run.inkX2 = x2 > W ? W : x2;
+  markDirty(label, run.inkX1, run.inkX2);
+  return true;
+}
+
+// Add a line of text; false when the label already holds MAX_TEXT_RUNS or
+// the text is longer than MAX_TEXT_RUN_LENGTH
+template <int W, int H>
+inline bool addText(TextLabel<W, H> &label, const Font &font, const char *text,
+                    int x, int y) {
+  if (label.runCount >= MAX_TEXT_RUNS) {
+    return false;
+  }
+  TextRun &run = label.runs[label.runCount];
+  run.font = &font;
+  run.x = x;
+  run.y = y;
+  if (!writeTextRun(label, run, text)) {
+    return false;
+  }
+  label.runCount++;
+  return true;
+}
+
+// Replace the text of run `index` (in addText order), marking the columns
+// of both the old and the new text dirty
+template <int W, int H>
+inline bool setText(TextLabel<W, H> &label, int index, const char *text) {
+  if (index < 0 || index >= label.runCount ||
+      strlen(text) > MAX_TEXT_RUN_LENGTH) {
+    return false;
+  }
+  TextRun &run = label.runs[index];
+  markDirty(label, run.inkX1, run.inkX2);
+  return writeTextRun(label, run, text);
+}
+
+template <int W, int H> inline void clearText(TextLabel<W, H> &label) {
+  for (int i = 0; i < label.runCount; i++) {
+    markDirty(label, label.runs[i].inkX1, label.runs[i].inkX2);
+  }
+  label.runCount = 0;
+}
+
+// Render printer-format columns [startCol, startCol + width) of a label into
+// dest (BYTES_PER_COLUMN bytes per column; cleared first)
+template <int W, int H>
+void renderTextColumns(const TextLabel<W, H> &label, int startCol, int width,
+                       uint8_t *dest);
+
+#endif // FONT_H
@@ -0,0 +1,412 @@
+#ifndef FONTS_FONT_5X7_H
+#define FONTS_FONT_5X7_H
+
+// Generated by tools/fontc.py from fonts/font_5x7.txt; do not edit.
+//
+// 5x7 proportional sans for labels: ASCII and Latin-1 (U+0020-U+00FF).
+//
+// Line box is 11 rows: rows 0-1 hold accents over capitals, rows 2-8 the
+// capitals (x-height rows 4-8), rows 9-10 descenders. The baseline is below
+// row 8. Digits are tabular (advance 6).
+
+#include <font.h>
+
+// Rows of each glyph, MSB-first, padded to whole bytes
+static constexpr uint8_t FONT_5X7_BITMAPS[] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x80, 0xA0, 0xA0, 0x50, 0x50, 0xF8,
+    0x50, 0xF8, 0x50, 0x50, 0x20, 0x78, 0xA0, 0x70, 0x28, 0xF0, 0x20, 0xC0,
+    0xC8, 0x10, 0x20, 0x40, 0x98, 0x18, 0x60, 0x90, 0xA0, 0x40, 0xA8, 0x90,
+    0x68, 0x80, 0x80, 0x20, 0x40, 0x80, 0x80, 0x80, 0x40, 0x20, 0x80, 0x40,
+    0x20, 0x20, 0x20, 0x40, 0x80, 0x20, 0xA8, 0x70, 0xA8, 0x20, 0x20, 0x20,
+    0xF8, 0x20, 0x20, 0x40, 0x40, 0x80, 0xF0, 0x80, 0x08, 0x10, 0x10, 0x20,
+    0x40, 0x40, 0x80, 0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x40, 0xC0,
+    0x40, 0x40, 0x40, 0x40, 0xE0, 0x70, 0x88, 0x08, 0x10, 0x20, 0x40, 0xF8,
+    0x70, 0x88, 0x08, 0x30, 0x08, 0x88, 0x70, 0x10, 0x30, 0x50, 0x90, 0xF8,
+    0x10, 0x10, 0xF8, 0x80, 0xF0, 0x08, 0x08, 0x88, 0x70, 0x30, 0x40, 0x80,
+    0xF0, 0x88, 0x88, 0x70, 0xF8, 0x08, 0x10, 0x20, 0x40, 0x40, 0x40, 0x70,
+    0x88, 0x88, 0x70, 0x88, 0x88, 0x70, 0x70, 0x88, 0x88, 0x78, 0x08, 0x10,
+    0x60, 0x80, 0x00, 0x00, 0x80, 0x40, 0x00, 0x00, 0x40, 0x40, 0x80, 0x10,
+    0x20, 0x40, 0x80, 0x40, 0x20, 0x10, 0xF0, 0x00, 0xF0, 0x80, 0x40, 0x20,
+    0x10, 0x20, 0x40, 0x80, 0x70, 0x88, 0x08, 0x10, 0x20, 0x00, 0x20, 0x70,
+    0x88, 0xB8, 0xA8, 0xB8, 0x80, 0x78, 0x70, 0x88, 0x88, 0xF8, 0x88, 0x88,
+    0x88, 0xF0, 0x88, 0x88, 0xF0, 0x88, 0x88, 0xF0, 0x70, 0x88, 0x80, 0x80,
+    0x80, 0x88, 0x70, 0xF0, 0x88, 0x88, 0x88, 0x88, 0x88, 0xF0, 0xF8, 0x80,
+    0x80, 0xF0, 0x80, 0x80, 0xF8, 0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0x80,
+    0x70, 0x88, 0x80, 0xB8, 0x88, 0x88, 0x78, 0x88, 0x88, 0x88, 0xF8, 0x88,
+    0x88, 0x88, 0xE0, 0x40, 0x40, 0x40, 0x40, 0x40, 0xE0, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x90, 0x60, 0x88, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x88, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0xF0, 0x88, 0xD8, 0xA8, 0xA8, 0x88, 0x88,
+    0x88, 0x88, 0x88, 0xC8, 0xA8, 0x98, 0x88, 0x88, 0x70, 0x88, 0x88, 0x88,
+    0x88, 0x88, 0x70, 0xF0, 0x88, 0x88, 0xF0, 0x80, 0x80, 0x80, 0x70, 0x88,
+    0x88, 0x88, 0xA8, 0x90, 0x68, 0xF0, 0x88, 0x88, 0xF0, 0xA0, 0x90, 0x88,
+    0x78, 0x80, 0x80, 0x70, 0x08, 0x08, 0xF0, 0xF8, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x88, 0x88, 0x88,
+    0x88, 0x88, 0x50, 0x20, 0x88, 0x88, 0x88, 0xA8, 0xA8, 0xA8, 0x50, 0x88,
+    0x88, 0x50, 0x20, 0x50, 0x88, 0x88, 0x88, 0x88, 0x50, 0x20, 0x20, 0x20,
+    0x20, 0xF8, 0x08, 0x10, 0x20, 0x40, 0x80, 0xF8, 0xE0, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0xE0, 0x80, 0x40, 0x40, 0x20, 0x10, 0x10, 0x08, 0xE0, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0xE0, 0x20, 0x50, 0x88, 0xF8, 0x80, 0x40, 0x70,
+    0x08, 0x78, 0x88, 0x78, 0x80, 0x80, 0xB0, 0xC8, 0x88, 0x88, 0xF0, 0x70,
+    0x80, 0x80, 0x80, 0x70, 0x08, 0x08, 0x68, 0x98, 0x88, 0x88, 0x78, 0x70,
+    0x88, 0xF8, 0x80, 0x70, 0x30, 0x40, 0xF0, 0x40, 0x40, 0x40, 0x40, 0x78,
+    0x88, 0x88, 0x88, 0x78, 0x08, 0x70, 0x80, 0x80, 0xB0, 0xC8, 0x88, 0x88,
+    0x88, 0x80, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x20, 0x00, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0xA0, 0x40, 0x80, 0x80, 0x90, 0xA0, 0xC0, 0xA0, 0x90,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0xD0, 0xA8, 0xA8, 0xA8, 0xA8,
+    0xB0, 0xC8, 0x88, 0x88, 0x88, 0x70, 0x88, 0x88, 0x88, 0x70, 0xF0, 0x88,
+    0x88, 0x88, 0xF0, 0x80, 0x80, 0x78, 0x88, 0x88, 0x88, 0x78, 0x08, 0x08,
+    0xB0, 0xC0, 0x80, 0x80, 0x80, 0x78, 0x80, 0x70, 0x08, 0xF0, 0x40, 0xF0,
+    0x40, 0x40, 0x40, 0x30, 0x88, 0x88, 0x88, 0x98, 0x68, 0x88, 0x88, 0x88,
+    0x50, 0x20, 0x88, 0x88, 0xA8, 0xA8, 0x50, 0x88, 0x50, 0x20, 0x50, 0x88,
+    0x88, 0x88, 0x88, 0x88, 0x78, 0x08, 0x70, 0xF8, 0x10, 0x20, 0x40, 0xF8,
+    0x20, 0x40, 0x40, 0x80, 0x40, 0x40, 0x20, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x40, 0x40, 0x20, 0x40, 0x40, 0x80, 0x40, 0xA8, 0x10,
+    0x80, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x20, 0x78, 0xA0, 0xA0, 0xA0,
+    0x78, 0x20, 0x30, 0x48, 0x40, 0xE0, 0x40, 0x40, 0xF8, 0x88, 0x70, 0x50,
+    0x70, 0x88, 0x88, 0x50, 0x20, 0xF8, 0x20, 0xF8, 0x20, 0x80, 0x80, 0x80,
+    0x00, 0x80, 0x80, 0x80, 0x70, 0x80, 0x60, 0x90, 0x60, 0x10, 0xE0, 0xA0,
+    0x7C, 0x82, 0x9A, 0xA2, 0x9A, 0x82, 0x7C, 0x60, 0x10, 0x70, 0x90, 0x70,
+    0x00, 0xF0, 0x28, 0x50, 0xA0, 0x50, 0x28, 0xF8, 0x08, 0x08, 0xF0, 0x7C,
+    0x82, 0xB2, 0xAA, 0xB2, 0xAA, 0x7C, 0xF8, 0x40, 0xA0, 0x40, 0x20, 0x20,
+    0xF8, 0x20, 0x20, 0x00, 0xF8, 0xC0, 0x20, 0x40, 0xE0, 0xC0, 0x20, 0x40,
+    0x20, 0xC0, 0x40, 0x80, 0x88, 0x88, 0x88, 0x98, 0xE8, 0x80, 0x80, 0x78,
+    0xE8, 0xE8, 0x68, 0x28, 0x28, 0x28, 0x80, 0x40, 0xC0, 0x40, 0xC0, 0x40,
+    0x40, 0xE0, 0x60, 0x90, 0x90, 0x60, 0x00, 0xF0, 0xA0, 0x50, 0x28, 0x50,
+    0xA0, 0x84, 0x88, 0x90, 0x24, 0x4C, 0x94, 0x1E, 0x84, 0x88, 0x90, 0x2C,
+    0x42, 0x84, 0x0E, 0xC4, 0x48, 0xD0, 0x64, 0xCC, 0x94, 0x1E, 0x20, 0x00,
+    0x20, 0x40, 0x80, 0x88, 0x70, 0x40, 0x20, 0x70, 0x88, 0x88, 0xF8, 0x88,
+    0x88, 0x88, 0x10, 0x20, 0x70, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x88, 0x20,
+    0x50, 0x70, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x88, 0x68, 0xB0, 0x70, 0x88,
+    0x88, 0xF8, 0x88, 0x88, 0x88, 0x50, 0x70, 0x88, 0x88, 0xF8, 0x88, 0x88,
+    0x88, 0x20, 0x50, 0x70, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x88, 0x78, 0xA0,
+    0xA0, 0xF8, 0xA0, 0xA0, 0xB8, 0x70, 0x88, 0x80, 0x80, 0x80, 0x88, 0x70,
+    0x20, 0x40, 0x40, 0x20, 0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0xF8, 0x10,
+    0x20, 0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0xF8, 0x20, 0x50, 0xF8, 0x80,
+    0x80, 0xF0, 0x80, 0x80, 0xF8, 0x50, 0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80,
+    0xF8, 0x80, 0x40, 0xE0, 0x40, 0x40, 0x40, 0x40, 0x40, 0xE0, 0x20, 0x40,
+    0xE0, 0x40, 0x40, 0x40, 0x40, 0x40, 0xE0, 0x40, 0xA0, 0xE0, 0x40, 0x40,
+    0x40, 0x40, 0x40, 0xE0, 0xA0, 0xE0, 0x40, 0x40, 0x40, 0x40, 0x40, 0xE0,
+    0xE0, 0x50, 0x48, 0xE8, 0x48, 0x50, 0xE0, 0x68, 0xB0, 0x88, 0x88, 0xC8,
+    0xA8, 0x98, 0x88, 0x88, 0x40, 0x20, 0x70, 0x88, 0x88, 0x88, 0x88, 0x88,
+    0x70, 0x10, 0x20, 0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x20, 0x50,
+    0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x68, 0xB0, 0x70, 0x88, 0x88,
+    0x88, 0x88, 0x88, 0x70, 0x50, 0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70,
+    0x88, 0x50, 0x20, 0x50, 0x88, 0x70, 0x98, 0xA8, 0xA8, 0xA8, 0xC8, 0x70,
+    0x40, 0x20, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x10, 0x20, 0x88,
+    0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x20, 0x50, 0x88, 0x88, 0x88, 0x88,
+    0x88, 0x88, 0x70, 0x50, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x10,
+    0x20, 0x88, 0x88, 0x50, 0x20, 0x20, 0x20, 0x20, 0x80, 0xF0, 0x88, 0x88,
+    0xF0, 0x80, 0x80, 0x60, 0x90, 0x90, 0xA0, 0x90, 0x88, 0xB0, 0x40, 0x20,
+    0x70, 0x08, 0x78, 0x88, 0x78, 0x10, 0x20, 0x70, 0x08, 0x78, 0x88, 0x78,
+    0x20, 0x50, 0x70, 0x08, 0x78, 0x88, 0x78, 0x68, 0xB0, 0x70, 0x08, 0x78,
+    0x88, 0x78, 0x50, 0x70, 0x08, 0x78, 0x88, 0x78, 0x20, 0x50, 0x20, 0x70,
+    0x08, 0x78, 0x88, 0x78, 0xD0, 0x28, 0x78, 0xA0, 0x58, 0x70, 0x80, 0x80,
+    0x80, 0x70, 0x40, 0x80, 0x40, 0x20, 0x70, 0x88, 0xF8, 0x80, 0x70, 0x10,
+    0x20, 0x70, 0x88, 0xF8, 0x80, 0x70, 0x20, 0x50, 0x70, 0x88, 0xF8, 0x80,
+    0x70, 0x50, 0x70, 0x88, 0xF8, 0x80, 0x70, 0x80, 0x40, 0x40, 0x40, 0x40,
+    0x40, 0x40, 0x40, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0xA0, 0x40,
+    0x40, 0x40, 0x40, 0x40, 0xA0, 0x40, 0x40, 0x40, 0x40, 0x40, 0x50, 0x20,
+    0x50, 0x08, 0x78, 0x88, 0x70, 0x68, 0xB0, 0xB0, 0xC8, 0x88, 0x88, 0x88,
+    0x40, 0x20, 0x70, 0x88, 0x88, 0x88, 0x70, 0x10, 0x20, 0x70, 0x88, 0x88,
+    0x88, 0x70, 0x20, 0x50, 0x70, 0x88, 0x88, 0x88, 0x70, 0x68, 0xB0, 0x70,
+    0x88, 0x88, 0x88, 0x70, 0x50, 0x70, 0x88, 0x88, 0x88, 0x70, 0x20, 0x00,
+    0xF8, 0x00, 0x20, 0x70, 0x98, 0xA8, 0xC8, 0x70, 0x40, 0x20, 0x88, 0x88,
+    0x88, 0x98, 0x68, 0x10, 0x20, 0x88, 0x88, 0x88, 0x98, 0x68, 0x20, 0x50,
+    0x88, 0x88, 0x88, 0x98, 0x68, 0x50, 0x88, 0x88, 0x88, 0x98, 0x68, 0x10,
+    0x20, 0x88, 0x88, 0x88, 0x88, 0x78, 0x08, 0x70, 0x80, 0x80, 0xF0, 0x88,
+    0x88, 0x88, 0xF0, 0x80, 0x80, 0x50, 0x88, 0x88, 0x88, 0x88, 0x78, 0x08,
+    0x70,
+};
+
+// Columns of each glyph, MSB-first, padded to whole bytes
+static constexpr uint8_t FONT_5X7_COLUMNS[] = {
+    0xFA, 0xC0, 0x00, 0xC0, 0x28, 0xFE, 0x28, 0xFE, 0x28, 0x24, 0x54, 0xFE,
+    0x54, 0x48, 0xC4, 0xC8, 0x10, 0x26, 0x46, 0x6C, 0x92, 0xAA, 0x44, 0x0A,
+    0xC0, 0x38, 0x44, 0x82, 0x82, 0x44, 0x38, 0x50, 0x20, 0xF8, 0x20, 0x50,
+    0x20, 0x20, 0xF8, 0x20, 0x20, 0x20, 0xC0, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x02, 0x0C, 0x10, 0x60, 0x80, 0x7C, 0x82, 0x82, 0x82, 0x7C, 0x42, 0xFE,
+    0x02, 0x42, 0x86, 0x8A, 0x92, 0x62, 0x44, 0x82, 0x92, 0x92, 0x6C, 0x18,
+    0x28, 0x48, 0xFE, 0x08, 0xE4, 0xA2, 0xA2, 0xA2, 0x9C, 0x3C, 0x52, 0x92,
+    0x92, 0x0C, 0x80, 0x8E, 0x90, 0xA0, 0xC0, 0x6C, 0x92, 0x92, 0x92, 0x6C,
+    0x60, 0x92, 0x92, 0x94, 0x78, 0x90, 0x04, 0x98, 0x10, 0x28, 0x44, 0x82,
+    0xA0, 0xA0, 0xA0, 0xA0, 0x82, 0x44, 0x28, 0x10, 0x40, 0x80, 0x8A, 0x90,
+    0x60, 0x7C, 0x82, 0xBA, 0xAA, 0x7A, 0x7E, 0x90, 0x90, 0x90, 0x7E, 0xFE,
+    0x92, 0x92, 0x92, 0x6C, 0x7C, 0x82, 0x82, 0x82, 0x44, 0xFE, 0x82, 0x82,
+    0x82, 0x7C, 0xFE, 0x92, 0x92, 0x92, 0x82, 0xFE, 0x90, 0x90, 0x90, 0x80,
+    0x7C, 0x82, 0x92, 0x92, 0x5E, 0xFE, 0x10, 0x10, 0x10, 0xFE, 0x82, 0xFE,
+    0x82, 0x04, 0x02, 0x02, 0xFC, 0xFE, 0x10, 0x28, 0x44, 0x82, 0xFE, 0x02,
+    0x02, 0x02, 0xFE, 0x40, 0x30, 0x40, 0xFE, 0xFE, 0x20, 0x10, 0x08, 0xFE,
+    0x7C, 0x82, 0x82, 0x82, 0x7C, 0xFE, 0x90, 0x90, 0x90, 0x60, 0x7C, 0x82,
+    0x8A, 0x84, 0x7A, 0xFE, 0x90, 0x98, 0x94, 0x62, 0x62, 0x92, 0x92, 0x92,
+    0x8C, 0x80, 0x80, 0xFE, 0x80, 0x80, 0xFC, 0x02, 0x02, 0x02, 0xFC, 0xF8,
+    0x04, 0x02, 0x04, 0xF8, 0xFC, 0x02, 0x1C, 0x02, 0xFC, 0xC6, 0x28, 0x10,
+    0x28, 0xC6, 0xC0, 0x20, 0x1E, 0x20, 0xC0, 0x86, 0x8A, 0x92, 0xA2, 0xC2,
+    0xFE, 0x82, 0x82, 0x80, 0x60, 0x10, 0x0C, 0x02, 0x82, 0x82, 0xFE, 0x20,
+    0x40, 0x80, 0x40, 0x20, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0x10,
+    0xA8, 0xA8, 0xA8, 0x78, 0xFE, 0x12, 0x22, 0x22, 0x1C, 0x70, 0x88, 0x88,
+    0x88, 0x1C, 0x22, 0x22, 0x12, 0xFE, 0x70, 0xA8, 0xA8, 0xA8, 0x60, 0x20,
+    0x7E, 0xA0, 0xA0, 0x70, 0x8A, 0x8A, 0x8A, 0xFC, 0xFE, 0x10, 0x20, 0x20,
+    0x1E, 0xBE, 0x01, 0x00, 0x00, 0x80, 0xBF, 0x00, 0xFE, 0x08, 0x14, 0x22,
+    0xFC, 0x02, 0xF8, 0x80, 0x78, 0x80, 0x78, 0xF8, 0x40, 0x80, 0x80, 0x78,
+    0x70, 0x88, 0x88, 0x88, 0x70, 0xFE, 0x88, 0x88, 0x88, 0x70, 0x70, 0x88,
+    0x88, 0x88, 0xFE, 0xF8, 0x40, 0x80, 0x80, 0x48, 0xA8, 0xA8, 0xA8, 0x90,
+    0x40, 0xF8, 0x44, 0x44, 0xF0, 0x08, 0x08, 0x10, 0xF8, 0xE0, 0x10, 0x08,
+    0x10, 0xE0, 0xF0, 0x08, 0x30, 0x08, 0xF0, 0x88, 0x50, 0x20, 0x50, 0x88,
+    0xF0, 0x0A, 0x0A, 0x0A, 0xFC, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x10, 0x6C,
+    0x82, 0xFE, 0x82, 0x6C, 0x10, 0x40, 0x80, 0x40, 0x20, 0x40, 0xBE, 0x38,
+    0x44, 0xFE, 0x44, 0x44, 0x12, 0x7E, 0x92, 0x82, 0x42, 0x88, 0x70, 0x50,
+    0x70, 0x88, 0x94, 0x54, 0x3E, 0x54, 0x94, 0xEE, 0x52, 0xAA, 0xAA, 0x94,
+    0x80, 0x00, 0x80, 0x7C, 0x82, 0x92, 0xAA, 0xAA, 0x82, 0x7C, 0x12, 0xAA,
+    0xAA, 0x7A, 0x20, 0x50, 0xA8, 0x50, 0x88, 0x80, 0x80, 0x80, 0x80, 0xE0,
+    0x80, 0x80, 0x80, 0x80, 0x7C, 0x82, 0xBE, 0xAA, 0x96, 0x82, 0x7C, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x40, 0xA0, 0x40, 0x22, 0x22, 0xFA, 0x22, 0x22,
+    0x90, 0xB0, 0x50, 0x88, 0xA8, 0x50, 0x40, 0x80, 0xFE, 0x08, 0x08, 0x10,
+    0xF8, 0x60, 0xF0, 0xFE, 0x80, 0xFE, 0x80, 0x40, 0xC0, 0x48, 0xF8, 0x08,
+    0x64, 0x94, 0x94, 0x64, 0x88, 0x50, 0xA8, 0x50, 0x20, 0xE4, 0x08, 0x10,
+    0x26, 0x4A, 0x9E, 0x02, 0xE4, 0x08, 0x10, 0x20, 0x52, 0x96, 0x0A, 0xAC,
+    0xF8, 0x10, 0x26, 0x4A, 0x9E, 0x02, 0x0C, 0x12, 0xA2, 0x02, 0x04, 0x1F,
+    0x80, 0xA4, 0x00, 0x64, 0x00, 0x24, 0x00, 0x1F, 0x80, 0x1F, 0x80, 0x24,
+    0x00, 0x64, 0x00, 0xA4, 0x00, 0x1F, 0x80, 0x1F, 0x80, 0x64, 0x00, 0xA4,
+    0x00, 0x64, 0x00, 0x1F, 0x80, 0x5F, 0x80, 0xA4, 0x00, 0xE4, 0x00, 0x64,
+    0x00, 0x9F, 0x80, 0x3F, 0xC8, 0x48, 0xC8, 0x3F, 0x1F, 0x80, 0x64, 0x00,
+    0xA4, 0x00, 0x64, 0x00, 0x1F, 0x80, 0x7E, 0x90, 0xFE, 0x92, 0x92, 0x7C,
+    0x00, 0x82, 0x80, 0x83, 0x00, 0x82, 0x00, 0x44, 0x00, 0x3F, 0x80, 0xA4,
+    0x80, 0x64, 0x80, 0x24, 0x80, 0x20, 0x80, 0x3F, 0x80, 0x24, 0x80, 0x64,
+    0x80, 0xA4, 0x80, 0x20, 0x80, 0x3F, 0x80, 0x64, 0x80, 0xA4, 0x80, 0x64,
+    0x80, 0x20, 0x80, 0x7F, 0xC9, 0x49, 0xC9, 0x41, 0xA0, 0x80, 0x7F, 0x80,
+    0x20, 0x80, 0x20, 0x80, 0x7F, 0x80, 0xA0, 0x80, 0x60, 0x80, 0xBF, 0x80,
+    0x60, 0x80, 0xC1, 0x7F, 0xC1, 0x92, 0xFE, 0x92, 0x44, 0x38, 0x7F, 0x80,
+    0x88, 0x00, 0xC4, 0x00, 0x42, 0x00, 0xBF, 0x80, 0x1F, 0x00, 0xA0, 0x80,
+    0x60, 0x80, 0x20, 0x80, 0x1F, 0x00, 0x1F, 0x00, 0x20, 0x80, 0x60, 0x80,
+    0xA0, 0x80, 0x1F, 0x00, 0x1F, 0x00, 0x60, 0x80, 0xA0, 0x80, 0x60, 0x80,
+    0x1F, 0x00, 0x5F, 0x00, 0xA0, 0x80, 0xE0, 0x80, 0x60, 0x80, 0x9F, 0x00,
+    0x3E, 0xC1, 0x41, 0xC1, 0x3E, 0x88, 0x50, 0x20, 0x50, 0x88, 0x7C, 0x86,
+    0xBA, 0xC2, 0x7C, 0x3F, 0x00, 0x80, 0x80, 0x40, 0x80, 0x00, 0x80, 0x3F,
+    0x00, 0x3F, 0x00, 0x00, 0x80, 0x40, 0x80, 0x80, 0x80, 0x3F, 0x00, 0x3F,
+    0x00, 0x40, 0x80, 0x80, 0x80, 0x40, 0x80, 0x3F, 0x00, 0x7E, 0x81, 0x01,
+    0x81, 0x7E, 0x30, 0x00, 0x08, 0x00, 0x47, 0x80, 0x88, 0x00, 0x30, 0x00,
+    0xFE, 0x48, 0x48, 0x48, 0x30, 0x7E, 0x80, 0x92, 0x6A, 0x04, 0x04, 0xAA,
+    0x6A, 0x2A, 0x1E, 0x04, 0x2A, 0x6A, 0xAA, 0x1E, 0x04, 0x6A, 0xAA, 0x6A,
+    0x1E, 0x44, 0xAA, 0xEA, 0x6A, 0x9E, 0x08, 0xD4, 0x54, 0xD4, 0x3C, 0x02,
+    0x55, 0xB5, 0x55, 0x0F, 0x90, 0xA8, 0x70, 0xA8, 0x68, 0x72, 0x8C, 0x88,
+    0x88, 0x1C, 0xAA, 0x6A, 0x2A, 0x18, 0x1C, 0x2A, 0x6A, 0xAA, 0x18, 0x1C,
+    0x6A, 0xAA, 0x6A, 0x18, 0x38, 0xD4, 0x54, 0xD4, 0x30, 0x80, 0x7E, 0x7E,
+    0x80, 0x40, 0xBE, 0x40, 0x80, 0x7C, 0x80, 0x04, 0xAA, 0x4A, 0xAA, 0x1C,
+    0x7E, 0x90, 0xE0, 0x60, 0x9E, 0x1C, 0xA2, 0x62, 0x22, 0x1C, 0x1C, 0x22,
+    0x62, 0xA2, 0x1C, 0x1C, 0x62, 0xA2, 0x62, 0x1C, 0x5C, 0xA2, 0xE2, 0x62,
+    0x9C, 0x38, 0xC4, 0x44, 0xC4, 0x38, 0x20, 0x20, 0xA8, 0x20, 0x20, 0x70,
+    0x98, 0xA8, 0xC8, 0x70, 0x3C, 0x82, 0x42, 0x04, 0x3E, 0x3C, 0x02, 0x42,
+    0x84, 0x3E, 0x3C, 0x42, 0x82, 0x44, 0x3E, 0x78, 0x84, 0x04, 0x88, 0x7C,
+    0x3C, 0x00, 0x02, 0x80, 0x42, 0x80, 0x82, 0x80, 0x3F, 0x00, 0xFF, 0x80,
+    0x22, 0x00, 0x22, 0x00, 0x22, 0x00, 0x1C, 0x00, 0x78, 0x85, 0x05, 0x85,
+    0x7E,
+};
+
+// {offset, columns, width, height, left, top, advance}
+static constexpr Glyph FONT_5X7_GLYPHS[] = {
+    {0, 0, 0, 0, 0, 0, 3}, // U+0020 space
+    {0, 0, 1, 7, 0, 2, 2}, // '!'
+    {7, 1, 3, 2, 0, 2, 4}, // '"'
+    {9, 4, 5, 7, 0, 2, 6}, // '#'
+    {16, 9, 5, 7, 0, 2, 6}, // '$'
+    {23, 14, 5, 7, 0, 2, 6}, // '%'
+    {30, 19, 5, 7, 0, 2, 6}, // '&'
+    {37, 24, 1, 2, 0, 2, 2}, // '''
+    {39, 25, 3, 7, 0, 2, 4}, // '('
+    {46, 28, 3, 7, 0, 2, 4}, // ')'
+    {53, 31, 5, 5, 0, 3, 6}, // '*'
+    {58, 36, 5, 5, 0, 3, 6}, // '+'
+    {63, 41, 2, 3, 0, 7, 3}, // ','
+    {66, 43, 4, 1, 0, 5, 5}, // '-'
+    {67, 47, 1, 1, 0, 8, 2}, // '.'
+    {68, 48, 5, 7, 0, 2, 6}, // '/'
+    {75, 53, 5, 7, 0, 2, 6}, // '0'
+    {82, 58, 3, 7, 1, 2, 6}, // '1'
+    {89, 61, 5, 7, 0, 2, 6}, // '2'
+    {96, 66, 5, 7, 0, 2, 6}, // '3'
+    {103, 71, 5, 7, 0, 2, 6}, // '4'
+    {110, 76, 5, 7, 0, 2, 6}, // '5'
+    {117, 81, 5, 7, 0, 2, 6}, // '6'
+    {124, 86, 5, 7, 0, 2, 6}, // '7'
+    {131, 91, 5, 7, 0, 2, 6}, // '8'
+    {138, 96, 5, 7, 0, 2, 6}, // '9'
+    {145, 101, 1, 4, 0, 4, 2}, // ':'
+    {149, 102, 2, 6, 0, 4, 3}, // ';'
+    {155, 104, 4, 7, 0, 2, 5}, // '<'
+    {162, 108, 4, 3, 0, 4, 5}, // '='
+    {165, 112, 4, 7, 0, 2, 5}, // '>'
+    {172, 116, 5, 7, 0, 2, 6}, // '?'
+    {179, 121, 5, 7, 0, 2, 6}, // '@'
+    {186, 126, 5, 7, 0, 2, 6}, // 'A'
+    {193, 131, 5, 7, 0, 2, 6}, // 'B'
+    {200, 136, 5, 7, 0, 2, 6}, // 'C'
+    {207, 141, 5, 7, 0, 2, 6}, // 'D'
+    {214, 146, 5, 7, 0, 2, 6}, // 'E'
+    {221, 151, 5, 7, 0, 2, 6}, // 'F'
+    {228, 156, 5, 7, 0, 2, 6}, // 'G'
+    {235, 161, 5, 7, 0, 2, 6}, // 'H'
+    {242, 166, 3, 7, 0, 2, 4}, // 'I'
+    {249, 169, 4, 7, 0, 2, 5}, // 'J'
+    {256, 173, 5, 7, 0, 2, 6}, // 'K'
+    {263, 178, 4, 7, 0, 2, 5}, // 'L'
+    {270, 182, 5, 7, 0, 2, 6}, // 'M'
+    {277, 187, 5, 7, 0, 2, 6}, // 'N'
+    {284, 192, 5, 7, 0, 2, 6}, // 'O'
+    {291, 197, 5, 7, 0, 2, 6}, // 'P'
+    {298, 202, 5, 7, 0, 2, 6}, // 'Q'
+    {305, 207, 5, 7, 0, 2, 6}, // 'R'
+    {312, 212, 5, 7, 0, 2, 6}, // 'S'
+    {319, 217, 5, 7, 0, 2, 6}, // 'T'
+    {326, 222, 5, 7, 0, 2, 6}, // 'U'
+    {333, 227, 5, 7, 0, 2, 6}, // 'V'
+    {340, 232, 5, 7, 0, 2, 6}, // 'W'
+    {347, 237, 5, 7, 0, 2, 6}, // 'X'
+    {354, 242, 5, 7, 0, 2, 6}, // 'Y'
+    {361, 247, 5, 7, 0, 2, 6}, // 'Z'
+    {368, 252, 3, 7, 0, 2, 4}, // '['
+    {375, 255, 5, 7, 0, 2, 6}, // U+005C backslash
+    {382, 260, 3, 7, 0, 2, 4}, // ']'
+    {389, 263, 5, 3, 0, 2, 6}, // '^'
+    {392, 268, 5, 1, 0, 8, 6}, // '_'
+    {393, 273, 2, 2, 0, 2, 3}, // '`'
+    {395, 275, 5, 5, 0, 4, 6}, // 'a'
+    {400, 280, 5, 7, 0, 2, 6}, // 'b'
+    {407, 285, 4, 5, 0, 4, 5}, // 'c'
+    {412, 289, 5, 7, 0, 2, 6}, // 'd'
+    {419, 294, 5, 5, 0, 4, 6}, // 'e'
+    {424, 299, 4, 7, 0, 2, 5}, // 'f'
+    {431, 303, 5, 7, 0, 4, 6}, // 'g'
+    {438, 308, 5, 7, 0, 2, 6}, // 'h'
+    {445, 313, 1, 7, 0, 2, 2}, // 'i'
+    {452, 314, 3, 9, 0, 2, 4}, // 'j'
+    {461, 320, 4, 7, 0, 2, 5}, // 'k'
+    {468, 324, 2, 7, 0, 2, 3}, // 'l'
+    {475, 326, 5, 5, 0, 4, 6}, // 'm'
+    {480, 331, 5, 5, 0, 4, 6}, // 'n'
+    {485, 336, 5, 5, 0, 4, 6}, // 'o'
+    {490, 341, 5, 7, 0, 4, 6}, // 'p'
+    {497, 346, 5, 7, 0, 4, 6}, // 'q'
+    {504, 351, 4, 5, 0, 4, 5}, // 'r'
+    {509, 355, 5, 5, 0, 4, 6}, // 's'
+    {514, 360, 4, 6, 0, 3, 5}, // 't'
+    {520, 364, 5, 5, 0, 4, 6}, // 'u'
+    {525, 369, 5, 5, 0, 4, 6}, // 'v'
+    {530, 374, 5, 5, 0, 4, 6}, // 'w'
+    {535, 379, 5, 5, 0, 4, 6}, // 'x'
+    {540, 384, 5, 7, 0, 4, 6}, // 'y'
+    {547, 389, 5, 5, 0, 4, 6}, // 'z'
+    {552, 394, 3, 7, 0, 2, 4}, // '{'
+    {559, 397, 1, 7, 0, 2, 2}, // '|'
+    {566, 398, 3, 7, 0, 2, 4}, // '}'
+    {573, 401, 5, 3, 0, 4, 6}, // '~'
+    {576, 406, 0, 0, 0, 0, 3}, // U+00A0 nbsp
+    {576, 406, 1, 7, 0, 4, 2}, // U+00A1 inverted !
+    {583, 407, 5, 7, 0, 2, 6}, // U+00A2 cent
+    {590, 412, 5, 7, 0, 2, 6}, // U+00A3 pound
+    {597, 417, 5, 5, 0, 3, 6}, // U+00A4 currency
+    {602, 422, 5, 7, 0, 2, 6}, // U+00A5 yen
+    {609, 427, 1, 7, 0, 2, 2}, // U+00A6 broken bar
+    {616, 428, 4, 7, 0, 2, 5}, // U+00A7 section
+    {623, 432, 3, 1, 0, 2, 4}, // U+00A8 diaeresis
+    {624, 435, 7, 7, 0, 2, 8}, // U+00A9 copyright
+    {631, 442, 4, 7, 0, 2, 5}, // U+00AA feminine ordinal
+    {638, 446, 5, 5, 0, 4, 6}, // U+00AB left guillemet
+    {643, 451, 5, 3, 0, 5, 6}, // U+00AC not
+    {646, 456, 4, 1, 0, 5, 5}, // U+00AD soft hyphen
+    {647, 460, 7, 7, 0, 2, 8}, // U+00AE registered
+    {654, 467, 5, 1, 0, 2, 6}, // U+00AF macron
+    {655, 472, 3, 3, 0, 2, 4}, // U+00B0 degree
+    {658, 475, 5, 7, 0, 2, 6}, // U+00B1 plus-minus
+    {665, 480, 3, 4, 0, 2, 4}, // U+00B2 superscript 2
+    {669, 483, 3, 5, 0, 2, 4}, // U+00B3 superscript 3
+    {674, 486, 2, 2, 0, 2, 3}, // U+00B4 acute
+    {676, 488, 5, 7, 0, 4, 6}, // U+00B5 micro
+    {683, 493, 5, 7, 0, 2, 6}, // U+00B6 pilcrow
+    {690, 498, 1, 1, 0, 5, 2}, // U+00B7 middle dot
+    {691, 499, 2, 2, 0, 9, 3}, // U+00B8 cedilla
+    {693, 501, 3, 5, 0, 2, 4}, // U+00B9 superscript 1
+    {698, 504, 4, 6, 0, 2, 5}, // U+00BA masculine ordinal
+    {704, 508, 5, 5, 0, 4, 6}, // U+00BB right guillemet
+    {709, 513, 7, 7, 0, 2, 8}, // U+00BC one quarter
+    {716, 520, 7, 7, 0, 2, 8}, // U+00BD one half
+    {723, 527, 7, 7, 0, 2, 8}, // U+00BE three quarters
+    {730, 534, 5, 7, 0, 2, 6}, // U+00BF inverted ?
+    {737, 539, 5, 9, 0, 0, 6}, // U+00C0 A + grave_upper
+    {746, 549, 5, 9, 0, 0, 6}, // U+00C1 A + acute_upper
+    {755, 559, 5, 9, 0, 0, 6}, // U+00C2 A + circumflex_upper
+    {764, 569, 5, 9, 0, 0, 6}, // U+00C3 A + tilde_upper
+    {773, 579, 5, 8, 0, 1, 6}, // U+00C4 A + diaeresis_upper
+    {781, 584, 5, 9, 0, 0, 6}, // U+00C5 A + ring_upper
+    {790, 594, 5, 7, 0, 2, 6}, // U+00C6 AE
+    {797, 599, 5, 9, 0, 2, 6}, // U+00C7 C + cedilla
+    {806, 609, 5, 9, 0, 0, 6}, // U+00C8 E + grave_upper
+    {815, 619, 5, 9, 0, 0, 6}, // U+00C9 E + acute_upper
+    {824, 629, 5, 9, 0, 0, 6}, // U+00CA E + circumflex_upper
+    {833, 639, 5, 8, 0, 1, 6}, // U+00CB E + diaeresis_upper
+    {841, 644, 3, 9, 0, 0, 4}, // U+00CC I + grave_upper
+    {850, 650, 3, 9, 0, 0, 4}, // U+00CD I + acute_upper
+    {859, 656, 3, 9, 0, 0, 4}, // U+00CE I + circumflex_upper
+    {868, 662, 3, 8, 0, 1, 4}, // U+00CF I + diaeresis_upper
+    {876, 665, 5, 7, 0, 2, 6}, // U+00D0 Eth
+    {883, 670, 5, 9, 0, 0, 6}, // U+00D1 N + tilde_upper
+    {892, 680, 5, 9, 0, 0, 6}, // U+00D2 O + grave_upper
+    {901, 690, 5, 9, 0, 0, 6}, // U+00D3 O + acute_upper
+    {910, 700, 5, 9, 0, 0, 6}, // U+00D4 O + circumflex_upper
+    {919, 710, 5, 9, 0, 0, 6}, // U+00D5 O + tilde_upper
+    {928, 720, 5, 8, 0, 1, 6}, // U+00D6 O + diaeresis_upper
+    {936, 725, 5, 5, 0, 3, 6}, // U+00D7 multiply
+    {941, 730, 5, 7, 0, 2, 6}, // U+00D8 O stroke
+    {948, 735, 5, 9, 0, 0, 6}, // U+00D9 U + grave_upper
+    {957, 745, 5, 9, 0, 0, 6}, // U+00DA U + acute_upper
+    {966, 755, 5, 9, 0, 0, 6}, // U+00DB U + circumflex_upper
+    {975, 765, 5, 8, 0, 1, 6}, // U+00DC U + diaeresis_upper
+    {983, 770, 5, 9, 0, 0, 6}, // U+00DD Y + acute_upper
+    {992, 780, 5, 7, 0, 2, 6}, // U+00DE Thorn
+    {999, 785, 5, 7, 0, 2, 6}, // U+00DF sharp s
+    {1006, 790, 5, 7, 0, 2, 6}, // U+00E0 a + grave_lower
+    {1013, 795, 5, 7, 0, 2, 6}, // U+00E1 a + acute_lower
+    {1020, 800, 5, 7, 0, 2, 6}, // U+00E2 a + circumflex_lower
+    {1027, 805, 5, 7, 0, 2, 6}, // U+00E3 a + tilde_lower
+    {1034, 810, 5, 6, 0, 3, 6}, // U+00E4 a + diaeresis_lower
+    {1040, 815, 5, 8, 0, 1, 6}, // U+00E5 a + ring_lower
+    {1048, 820, 5, 5, 0, 4, 6}, // U+00E6 ae
+    {1053, 825, 4, 7, 0, 4, 5}, // U+00E7 c + cedilla
+    {1060, 829, 5, 7, 0, 2, 6}, // U+00E8 e + grave_lower
+    {1067, 834, 5, 7, 0, 2, 6}, // U+00E9 e + acute_lower
+    {1074, 839, 5, 7, 0, 2, 6}, // U+00EA e + circumflex_lower
+    {1081, 844, 5, 6, 0, 3, 6}, // U+00EB e + diaeresis_lower
+    {1087, 849, 2, 7, 0, 2, 4}, // U+00EC dotless_i + grave_lower
+    {1094, 851, 2, 7, 1, 2, 4}, // U+00ED dotless_i + acute_lower
+    {1101, 853, 3, 7, 0, 2, 4}, // U+00EE dotless_i + circumflex_lower
+    {1108, 856, 3, 6, 0, 3, 4}, // U+00EF dotless_i + diaeresis_lower
+    {1114, 859, 5, 7, 0, 2, 6}, // U+00F0 eth
+    {1121, 864, 5, 7, 0, 2, 6}, // U+00F1 n + tilde_lower
+    {1128, 869, 5, 7, 0, 2, 6}, // U+00F2 o + grave_lower
+    {1135, 874, 5, 7, 0, 2, 6}, // U+00F3 o + acute_lower
+    {1142, 879, 5, 7, 0, 2, 6}, // U+00F4 o + circumflex_lower
+    {1149, 884, 5, 7, 0, 2, 6}, // U+00F5 o + tilde_lower
+    {1156, 889, 5, 6, 0, 3, 6}, // U+00F6 o + diaeresis_lower
+    {1162, 894, 5, 5, 0, 3, 6}, // U+00F7 divide
+    {1167, 899, 5, 5, 0, 4, 6}, // U+00F8 o stroke
+    {1172, 904, 5, 7, 0, 2, 6}, // U+00F9 u + grave_lower
+    {1179, 909, 5, 7, 0, 2, 6}, // U+00FA u + acute_lower
+    {1186, 914, 5, 7, 0, 2, 6}, // U+00FB u + circumflex_lower
+    {1193, 919, 5, 6, 0, 3, 6}, // U+00FC u + diaeresis_lower
+    {1199, 924, 5, 9, 0, 2, 6}, // U+00FD y + acute_lower
+    {1208, 934, 5, 9, 0, 2, 6}, // U+00FE thorn
+    {1217, 944, 5, 8, 0, 3, 6}, // U+00FF y + diaeresis_lower
+};
+
+// {first code point, count, first glyph}
+static constexpr FontRange FONT_5X7_RANGES[] = {
+    {0x0020, 95, 0},
+    {0x00A0, 96, 95},
+};
+
+const Font FONT_5X7 = {
+    FONT_5X7_BITMAPS, FONT_5X7_COLUMNS, nullptr, nullptr,
+    FONT_5X7_GLYPHS, FONT_5X7_RANGES,
+    sizeof(FONT_5X7_RANGES) / sizeof(FONT_5X7_RANGES[0]),
+    11, 9, 31};
+
+#endif // FONTS_FONT_5X7_H
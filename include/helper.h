@@ -8,8 +8,20 @@
 #define IMAGE_WIDTH 255
 #define IMAGE_HEIGHT 96
 
-// round up bits -> bytes
-#define BITMAP_SIZE (((IMAGE_WIDTH) * (IMAGE_HEIGHT) + 7) / 8)
+// Printable height (dots) per tape width. 96 matches the captured 12mm jobs;
+// the others assume the same 8 dots/mm head, rounded down to a multiple of 16
+// rows because the printer format swaps 16-bit row pairs.
+#define TAPE_9MM_HEIGHT 64
+#define TAPE_12MM_HEIGHT 96
+#define TAPE_16MM_HEIGHT 128
+
+// Columns per compressed frame (printer limit)
+#define DEFAULT_CHUNK_WIDTH 85
+
+// Each row is padded to a whole number of 32-bit words, so every row starts on
+// a byte (and word) boundary. Padding bits past IMAGE_WIDTH are don't-care.
+#define BITMAP_STRIDE ((((IMAGE_WIDTH) + 31) / 32) * 4)
+#define BITMAP_SIZE ((BITMAP_STRIDE) * (IMAGE_HEIGHT))
 #define MAX_COMPRESSED_SIZE (BITMAP_SIZE + BITMAP_SIZE / 16 + 64 + 3)
 
 struct Pixel {
@@ -18,17 +30,267 @@ struct Pixel {
   bool black;
 };
 
-struct Bitmap {
-  uint8_t data[BITMAP_SIZE];
+// Columns [x1, x2) modified since the frame generator last compressed a
+// canvas; x1 >= x2 means clean. It is bookkeeping rather than pixel state, so
+// canvases keep it mutable and the generator can reset it through a const
+// reference. Draw functions mark what they touch; code writing to data[]
+// directly must call markDirty() itself.
+struct DirtyColumns {
+  static constexpr int ALL = 0xFFFF; // past the widest possible canvas
+
+  int x1;
+  int x2;
+
+  // A new canvas has never been compressed, so it starts fully dirty. Copies
+  // have a new identity (or new contents when assigned), so they do too.
+  DirtyColumns() : x1(0), x2(ALL) {}
+  DirtyColumns(const DirtyColumns &) : x1(0), x2(ALL) {}
+  DirtyColumns &operator=(const DirtyColumns &) {
+    x1 = 0;
+    x2 = ALL;
+    return *this;
+  }
+};
+
+// Clip rectangle [x1, x2) x [y1, y2); empty when x1 >= x2 or y1 >= y2
+struct ClipRect {
+  int x1;
+  int y1;
+  int x2;
+  int y2;
 };
 
+// Drawing is confined to rect, which always lies inside the canvas, so
+// primitives clip against it once at entry and run their inner loops without
+// bounds checks. pushClip() narrows it for a nested region (a table cell, a
+// label field) and popClip() restores the enclosing one.
+template <int Width, int Height> struct ClipStack {
+  static constexpr int MAX_DEPTH = 4;
+
+  ClipRect rect;
+  ClipRect saved[MAX_DEPTH];
+  int depth;
+
+  ClipStack() : depth(0) {
+    rect.x1 = 0;
+    rect.y1 = 0;
+    rect.x2 = Width;
+    rect.y2 = Height;
+  }
+};
+
+template <int W, int H> constexpr int ClipStack<W, H>::MAX_DEPTH;
+
+// Geometry shared by every canvas of a given size. All of it is constexpr so
+// loops over a canvas are specialized per tape size at compile time.
+template <int Width, int Height> struct CanvasGeometry {
+  static_assert(Width > 0 && Width <= 0xFFFF, "width must fit the frame");
+  static_assert(Height > 0 && Height % 16 == 0,
+                "height must be a multiple of 16 rows");
+
+  static constexpr int WIDTH = Width;
+  static constexpr int HEIGHT = Height;
+  static constexpr int BYTES_PER_COLUMN = Height / 8; // printer format
+  static constexpr size_t PRINTER_FORMAT_SIZE =
+      (size_t)Width * BYTES_PER_COLUMN;
+  static constexpr int CHUNK_COUNT =
+      (Width + DEFAULT_CHUNK_WIDTH - 1) / DEFAULT_CHUNK_WIDTH;
+  static constexpr int LAST_CHUNK_WIDTH =
+      Width - (CHUNK_COUNT - 1) * DEFAULT_CHUNK_WIDTH;
+};
+
+template <int W, int H> constexpr int CanvasGeometry<W, H>::WIDTH;
+template <int W, int H> constexpr int CanvasGeometry<W, H>::HEIGHT;
+template <int W, int H> constexpr int CanvasGeometry<W, H>::BYTES_PER_COLUMN;
+template <int W, int H>
+constexpr size_t CanvasGeometry<W, H>::PRINTER_FORMAT_SIZE;
+template <int W, int H> constexpr int CanvasGeometry<W, H>::CHUNK_COUNT;
+template <int W, int H> constexpr int CanvasGeometry<W, H>::LAST_CHUNK_WIDTH;
+
+// Row-major 1-bit canvas
+template <int Width, int Height>
+struct BasicBitmap : CanvasGeometry<Width, Height> {
+  static constexpr int STRIDE = ((Width + 31) / 32) * 4; // bytes per row
+  static constexpr size_t SIZE = (size_t)STRIDE * Height;
+
+  typedef void (*Operation)(BasicBitmap &);
+  typedef ClipStack<Width, Height> ClipStackType;
+
+  uint8_t data[SIZE];
+  mutable DirtyColumns dirty;
+  ClipStackType clip;
+};
+
+template <int W, int H> constexpr int BasicBitmap<W, H>::STRIDE;
+template <int W, int H> constexpr size_t BasicBitmap<W, H>::SIZE;
+
+// Canvas stored directly in the printer's column format, so it can be
+// compressed without a transform pass. Each column is BYTES_PER_COLUMN bytes;
+// row y lives in byte (y / 8) ^ 1 of its column (the 16-bit word swap), MSB =
+// topmost row of that byte. Read as little-endian 16-bit words, a column is a
+// plain MSB-first bit stream from the top row down.
+template <int Width, int Height>
+struct PrinterBitmap : CanvasGeometry<Width, Height> {
+  static constexpr size_t SIZE =
+      CanvasGeometry<Width, Height>::PRINTER_FORMAT_SIZE;
+
+  typedef ClipStack<Width, Height> ClipStackType;
+
+  uint8_t data[SIZE];
+  mutable DirtyColumns dirty;
+  ClipStackType clip;
+};
+
+template <int W, int H> constexpr size_t PrinterBitmap<W, H>::SIZE;
+
+// Read-only view of any MSB-first, row-major 1-bit image: a canvas, an icon
+// in flash or a pre-rendered strip of text
+struct BitmapView {
+  const uint8_t *data;
+  int width;
+  int height;
+  int stride; // bytes per row
+};
+
+template <int W, int H>
+inline BitmapView bitmapView(const BasicBitmap<W, H> &bitmap) {
+  BitmapView view = {bitmap.data, W, H, BasicBitmap<W, H>::STRIDE};
+  return view;
+}
+
+typedef BasicBitmap<IMAGE_WIDTH, TAPE_9MM_HEIGHT> Bitmap9mm;
+typedef BasicBitmap<IMAGE_WIDTH, TAPE_12MM_HEIGHT> Bitmap12mm;
+typedef BasicBitmap<IMAGE_WIDTH, TAPE_16MM_HEIGHT> Bitmap16mm;
+
+// Default canvas, the one the rest of the firmware was written against
+typedef BasicBitmap<IMAGE_WIDTH, IMAGE_HEIGHT> Bitmap;
+
+typedef PrinterBitmap<IMAGE_WIDTH, TAPE_9MM_HEIGHT> PrinterBitmap9mm;
+typedef PrinterBitmap<IMAGE_WIDTH, TAPE_12MM_HEIGHT> PrinterBitmap12mm;
+typedef PrinterBitmap<IMAGE_WIDTH, TAPE_16MM_HEIGHT> PrinterBitmap16mm;
+
+// Every canvas size templates are explicitly instantiated for. Translation
+// units pass a macro taking (width, height).
+#define FOR_EACH_TAPE_BITMAP(X)                                                \
+  X(IMAGE_WIDTH, TAPE_9MM_HEIGHT)                                              \
+  X(IMAGE_WIDTH, TAPE_12MM_HEIGHT)                                             \
+  X(IMAGE_WIDTH, TAPE_16MM_HEIGHT)
+
+// First byte of row y (no bounds check)
+template <int W, int H>
+inline uint8_t *bitmapRow(BasicBitmap<W, H> &bitmap, int y) {
+  return bitmap.data + y * BasicBitmap<W, H>::STRIDE;
+}
+template <int W, int H>
+inline const uint8_t *bitmapRow(const BasicBitmap<W, H> &bitmap, int y) {
+  return bitmap.data + y * BasicBitmap<W, H>::STRIDE;
+}
+
+// First byte of column x of a printer-format canvas (no bounds check)
+template <int W, int H>
+inline uint8_t *bitmapColumn(PrinterBitmap<W, H> &bitmap, int x) {
+  return bitmap.data + x * PrinterBitmap<W, H>::BYTES_PER_COLUMN;
+}
+template <int W, int H>
+inline const uint8_t *bitmapColumn(const PrinterBitmap<W, H> &bitmap, int x) {
+  return bitmap.data + x * PrinterBitmap<W, H>::BYTES_PER_COLUMN;
+}
+
+// Grow the dirty range to cover columns [x1, x2) (callers pass clipped ranges)
+template <typename BitmapT>
+inline void markDirty(const BitmapT &bitmap, int x1, int x2) {
+  if (x1 >= x2)
+    return;
+  if (bitmap.dirty.x1 >= bitmap.dirty.x2) {
+    bitmap.dirty.x1 = x1;
+    bitmap.dirty.x2 = x2;
+    return;
+  }
+  if (x1 < bitmap.dirty.x1)
+    bitmap.dirty.x1 = x1;
+  if (x2 > bitmap.dirty.x2)
+    bitmap.dirty.x2 = x2;
+}
+
+template <typename BitmapT> inline void markAllDirty(const BitmapT &bitmap) {
+  bitmap.dirty.x1 = 0;
+  bitmap.dirty.x2 = DirtyColumns::ALL;
+}
+
+template <typename BitmapT> inline void markClean(const BitmapT &bitmap) {
+  bitmap.dirty.x1 = 0;
+  bitmap.dirty.x2 = 0;
+}
+
+// True if any column in [x1, x2) changed since the last compression
+template <typename BitmapT>
+inline bool isDirty(const BitmapT &bitmap, int x1, int x2) {
+  return bitmap.dirty.x1 < x2 && x1 < bitmap.dirty.x2;
+}
+
+// Narrow the clip to its intersection with [x1, x2) x [y1, y2). Returns false
+// (clip unchanged) when the stack is full.
+template <typename BitmapT>
+inline bool pushClip(BitmapT &bitmap, int x1, int y1, int x2, int y2) {
+  ClipRect &rect = bitmap.clip.rect;
+  if (bitmap.clip.depth >= BitmapT::ClipStackType::MAX_DEPTH) {
+    return false;
+  }
+  bitmap.clip.saved[bitmap.clip.depth++] = rect;
+
+  if (x1 > rect.x1)
+    rect.x1 = x1;
+  if (y1 > rect.y1)
+    rect.y1 = y1;
+  if (x2 < rect.x2)
+    rect.x2 = x2;
+  if (y2 < rect.y2)
+    rect.y2 = y2;
+  return true;
+}
+
+// Restore the clip active before the matching pushClip()
+template <typename BitmapT> inline void popClip(BitmapT &bitmap) {
+  if (bitmap.clip.depth > 0) {
+    bitmap.clip.rect = bitmap.clip.saved[--bitmap.clip.depth];
+  }
+}
+
+template <typename BitmapT>
+inline bool clipContains(const BitmapT &bitmap, int x, int y) {
+  const ClipRect &rect = bitmap.clip.rect;
+  return x >= rect.x1 && x < rect.x2 && y >= rect.y1 && y < rect.y2;
+}
+
+// True when nothing is clipped away
+template <typename BitmapT> inline bool clipIsCanvas(const BitmapT &bitmap) {
+  const ClipRect &rect = bitmap.clip.rect;
+  return rect.x1 == 0 && rect.y1 == 0 && rect.x2 == BitmapT::WIDTH &&
+         rect.y2 == BitmapT::HEIGHT;
+}
+
+// Byte of a printer-format column holding row y, and its bit mask
+inline int columnByteIndex(int y) { return (y >> 3) ^ 1; }
+inline uint8_t columnBitMask(int y) { return 0x80 >> (y & 7); }
+
+// Bulk kernels: word-at-a-time (SIMD on host builds), any alignment
 void clearBuffer(uint8_t *buf, size_t len);
+void fillBuffer(uint8_t *buf, size_t len, uint8_t value);
 void copyBuffer(uint8_t *dst, const uint8_t *src, size_t len);
+void invertBuffer(uint8_t *buf, size_t len);
+// Transpose an 8x8 bit block: bit (7 - c) of src row r becomes bit (7 - r) of
+// dst row c, rows `stride` bytes apart. Branch-free; src and dst may not
+// overlap.
+void transposeBits8x8(const uint8_t *src, int srcStride, uint8_t *dst,
+                      int dstStride);
 int pixelToIndex(int x, int y);
 int indexToByte(int idx);
 int indexToBit(int idx);
 uint8_t bitMask(int bitPos);
-bool isPixelBlack(const Bitmap &bitmap, int x, int y);
+template <int W, int H>
+bool isPixelBlack(const BasicBitmap<W, H> &bitmap, int x, int y);
+template <int W, int H>
+bool isPixelBlack(const PrinterBitmap<W, H> &bitmap, int x, int y);
 uint8_t calculateChecksum(const uint8_t *data, size_t len);
 
 // Safety helper: return true if byte index is valid for the Bitmap
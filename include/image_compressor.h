@@ -2,13 +2,11 @@
 #define IMAGE_COMPRESSOR_H
 
 #include <cstdint>
+#include <font.h>
 #include <helper.h>
 #include <minilzo.h>
 #include <vector>
 
-#define MAX_COMPRESSED_SIZE (BITMAP_SIZE + BITMAP_SIZE / 16 + 64 + 3)
-#define DEFAULT_CHUNK_WIDTH 85
-#define BYTES_PER_COLUMN 12
 #define CID_0004_HEADER_BYTES 7
 
 // Frame structure for BLE transmission
@@ -19,33 +17,41 @@ struct PrinterFrame {
   bool isContinuation;
 };
 
-// CHANGED: No more global static arrays - use dynamic allocation
-struct CompressionBuffers {
-  uint8_t *lzoWorkMem;
-  uint8_t *compressed;
-  Bitmap *printerFormatBuffer;
-
-  CompressionBuffers();
-  ~CompressionBuffers();
-  bool isValid() const;
-};
-
 // Initialize compression system (call once at startup)
 bool initCompression();
 void cleanupCompression();
 
-void transformToPrinterFormat(const Bitmap &source, Bitmap &dest);
-void transformToColumnMajor(const Bitmap &source, Bitmap &dest);
-void transform16BitSwap(Bitmap &bitmap);
-
-void extractChunkColumns(const Bitmap &printerFormat, Bitmap &chunk,
-                         int startCol, int chunkWidth);
-
-std::vector<PrinterFrame> compressAndGenerateFrames(const Bitmap &userBitmap,
-                                                    uint16_t mtu);
+// Transforms and frame generation are instantiated for every
+// FOR_EACH_TAPE_BITMAP size in image_compressor.cpp
+template <int W, int H>
+void transformToPrinterFormat(const BasicBitmap<W, H> &source,
+                              BasicBitmap<W, H> &dest);
+template <int W, int H>
+void transformToPrinterFormat(const BasicBitmap<W, H> &source,
+                              PrinterBitmap<W, H> &dest);
+template <int W, int H>
+void transformToColumnMajor(const BasicBitmap<W, H> &source,
+                            BasicBitmap<W, H> &dest);
+template <int W, int H> void transform16BitSwap(BasicBitmap<W, H> &bitmap);
+
+// Compressed chunks are cached per canvas: printing the same canvas again
+// only recompresses chunks overlapping its dirty columns (see DirtyColumns),
+// and the canvas is marked clean afterwards.
+template <int W, int H>
+std::vector<PrinterFrame>
+compressAndGenerateFrames(const BasicBitmap<W, H> &userBitmap, uint16_t mtu);
+// No transform pass: chunk columns are compressed straight from the canvas
+template <int W, int H>
+std::vector<PrinterFrame>
+compressAndGenerateFrames(const PrinterBitmap<W, H> &userBitmap, uint16_t mtu);
+// No canvas: each chunk's glyph columns are rendered into the chunk buffer
+template <int W, int H>
+std::vector<PrinterFrame>
+compressAndGenerateFrames(const TextLabel<W, H> &label, uint16_t mtu);
 std::vector<uint8_t> createBLEFrame(const uint8_t *compressedData,
                                     size_t compressedSize,
                                     uint16_t framesRemaining,
-                                    uint8_t chunkWidth);
+                                    uint8_t chunkWidth,
+                                    uint16_t bitmapWidth = IMAGE_WIDTH);
 
 #endif // !IMAGE_COMPRESSOR_H
@@ -0,0 +1,67 @@
+#ifndef IMAGE_SCALER_H
+#define IMAGE_SCALER_H
+
+#include <dither.h>
+
+// ============================================================================
+// IMAGE SCALING
+// Grayscale sources of any size, resized on the way into the dithering stage.
+// Source rows are pushed one at a time and every finished output row goes
+// straight to a Ditherer, so memory stays at one row of accumulators however
+// large the source is.
+//
+// Shrinking averages the source area under each output pixel, with exact
+// integer weights; enlarging repeats the nearest source pixel. Each axis
+// picks its own mode.
+// ============================================================================
+
+// Largest source (width * height) the 32-bit accumulators can average
+#define MAX_SCALE_SOURCE_PIXELS 16843009 // (2^32 - 1) / 255
+
+struct ImageScaler {
+  int sourceWidth;
+  int sourceHeight;
+  int width; // output size
+  int height;
+  int sourceRow; // next row expected
+  int outputRow; // next row to finish
+  uint32_t columnScale; // sum of the horizontal weights of an output pixel
+  uint32_t sums[MAX_DITHER_WIDTH];    // output row being averaged
+  uint32_t columns[MAX_DITHER_WIDTH]; // current source row, resized
+  uint8_t sampleColumns[MAX_DITHER_WIDTH]; // source column when enlarging
+  uint8_t row[MAX_DITHER_WIDTH];
+  Ditherer ditherer;
+};
+
+// Size of the source scaled to `height` rows with its aspect ratio kept,
+// made smaller still if it would be wider than MAX_DITHER_WIDTH. Returns
+// false for an empty source, one over MAX_SCALE_SOURCE_PIXELS, or height < 1.
+bool fitImage(int sourceWidth, int sourceHeight, int height, int &fitWidth,
+              int &fitHeight);
+
+// Scale a sourceWidth x sourceHeight image as fitImage does and dither it
+// with its top-left pixel at (x, y). False if fitImage fails.
+bool startImageScaler(ImageScaler &scaler, int sourceWidth, int sourceHeight,
+                      int x, int y, int height, DitherMethod method);
+
+// Push the next source row (sourceWidth pixels). Finished output rows are
+// dithered into the canvas; rows past sourceHeight are ignored.
+template <int W, int H>
+void scaleRow(BasicBitmap<W, H> &bitmap, ImageScaler &scaler,
+              const uint8_t *source);
+template <int W, int H>
+void scaleRow(PrinterBitmap<W, H> &bitmap, ImageScaler &scaler,
+              const uint8_t *source);
+
+// Whole source already in memory, rows `stride` bytes apart; pass the canvas
+// height to fill the tape
+template <int W, int H>
+bool drawScaledImage(BasicBitmap<W, H> &bitmap, const uint8_t *gray,
+                     int sourceWidth, int sourceHeight, int stride, int x,
+                     int y, int height, DitherMethod method);
+template <int W, int H>
+bool drawScaledImage(PrinterBitmap<W, H> &bitmap, const uint8_t *gray,
+                     int sourceWidth, int sourceHeight, int stride, int x,
+                     int y, int height, DitherMethod method);
+
+#endif // IMAGE_SCALER_H
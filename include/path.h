@@ -0,0 +1,135 @@
+#ifndef PATH_H
+#define PATH_H
+
+#include <bitmap_operation.h>
+#include <helper.h>
+
+// ============================================================================
+// PATHS
+// Outlines made of lines and Bezier curves, filled by a scanline rasterizer
+// that writes one horizontal span per inside run. Curves are flattened to
+// lines when they are added, so a Path is a list of polygons (contours).
+//
+// Coordinates are pixel corners: the square 0,0 10,0 10,10 0,10 covers
+// pixels 0-9 on both axes, and a pixel is inside when its centre is. Points
+// are kept in 1/PATH_SUBPIXEL pixel units so flattened curves stay smooth.
+// ============================================================================
+
+#define PATH_SUBPIXEL 16
+#define MAX_PATH_POINTS 256
+#define MAX_PATH_CONTOURS 32
+
+// Largest distance, in subpixels, of a flattened curve from the true curve
+#define PATH_FLATNESS 4
+
+struct PathPoint {
+  int32_t x; // subpixels
+  int32_t y;
+};
+
+struct Path {
+  PathPoint points[MAX_PATH_POINTS];
+  int pointCount;
+  // One past the last point of each finished contour; points after the last
+  // end belong to the contour still being built
+  uint16_t contourEnds[MAX_PATH_CONTOURS];
+  bool contourClosed[MAX_PATH_CONTOURS];
+  int contourCount;
+  bool overflow; // a point or contour did not fit and was dropped
+
+  Path() : pointCount(0), contourCount(0), overflow(false) {}
+};
+
+enum FillRule {
+  FILL_NON_ZERO, // inside where the contours wind around the point at all
+  FILL_EVEN_ODD, // inside where a ray crosses an odd number of edges
+};
+
+void clearPath(Path &path);
+
+// Start a new contour at (x, y)
+bool moveTo(Path &path, int x, int y);
+// The segment builders continue from the current point (after closePath,
+// the start of the closed contour; on an empty path, their first coordinate
+// pair) and return false once the path is full
+bool lineTo(Path &path, int x, int y);
+// Quadratic Bezier with control point (cx, cy)
+bool quadTo(Path &path, int cx, int cy, int x, int y);
+// Cubic Bezier with control points (c1x, c1y) and (c2x, c2y)
+bool cubicTo(Path &path, int c1x, int c1y, int c2x, int c2y, int x, int y);
+// Close the current contour back to its first point. Filling closes every
+// contour anyway; this matters for strokes.
+void closePath(Path &path);
+
+// Fill the area inside the path
+template <int W, int H>
+void fillPath(BasicBitmap<W, H> &bitmap, const Path &path,
+              FillRule rule = FILL_NON_ZERO);
+template <int W, int H>
+void fillPath(PrinterBitmap<W, H> &bitmap, const Path &path,
+              FillRule rule = FILL_NON_ZERO);
+
+// ============================================================================
+// STROKES
+// A stroke becomes polygons (a quad per segment plus caps and joins) that are
+// filled together with the non-zero rule, so overlapping pieces merge and
+// each scanline run is written once. Stroke coordinates address pixel
+// centres like drawLine and drawRect: a width-1 stroke with square caps
+// covers the pixels drawLine does (exactly for straight and 45 degree lines,
+// within a pixel at other slopes).
+// ============================================================================
+
+enum LineCap {
+  CAP_BUTT,   // ends flush with the end point
+  CAP_SQUARE, // extended by half the width
+  CAP_ROUND,
+};
+
+enum LineJoin {
+  JOIN_MITER, // sharp corner, bevelled past STROKE_MITER_LIMIT
+  JOIN_BEVEL,
+  JOIN_ROUND,
+};
+
+#define MAX_DASHES 8
+
+// Longest miter, in stroke widths, before a join is bevelled instead
+#define STROKE_MITER_LIMIT 4
+
+struct StrokeStyle {
+  int width;
+  LineCap cap;
+  LineJoin join;
+  // Alternating on and off lengths in pixels, starting with on (an odd list
+  // is repeated to make it even); dashCount 0 strokes solid. Every dash gets
+  // the caps, so round caps with on-length 0 make dots.
+  int dashes[MAX_DASHES];
+  int dashCount;
+  int dashOffset; // pixels into the pattern where the stroke starts
+};
+
+// Stroke every contour of a path; closed contours get a join where they meet
+// their start instead of caps
+template <int W, int H>
+void strokePath(BasicBitmap<W, H> &bitmap, const Path &path,
+                const StrokeStyle &style);
+template <int W, int H>
+void strokePath(PrinterBitmap<W, H> &bitmap, const Path &path,
+                const StrokeStyle &style);
+
+template <int W, int H>
+void drawThickLine(BasicBitmap<W, H> &bitmap, int x0, int y0, int x1, int y1,
+                   const StrokeStyle &style);
+template <int W, int H>
+void drawThickLine(PrinterBitmap<W, H> &bitmap, int x0, int y0, int x1,
+                   int y1, const StrokeStyle &style);
+
+// Rectangle outline through the inclusive corners, like drawRect
+template <int W, int H>
+void drawThickRect(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2,
+                   const StrokeStyle &style);
+template <int W, int H>
+void drawThickRect(PrinterBitmap<W, H> &bitmap, int x1, int y1, int x2,
+                   int y2, const StrokeStyle &style);
+
+#endif // PATH_H
@@ -0,0 +1,68 @@
+#ifndef QR_CODE_H
+#define QR_CODE_H
+
+#include <bitmap_operation.h>
+#include <helper.h>
+
+// ============================================================================
+// QR CODES
+// Versions 1-6 (21x21 to 41x41 modules), which is what fits across a tape.
+// The matrix is bit-packed one 64-bit word per row, so mask evaluation works
+// on whole rows with shifts and popcounts. Encoding uses fixed buffers only.
+// ============================================================================
+
+#define QR_MAX_VERSION 6
+#define QR_MAX_SIZE (17 + 4 * QR_MAX_VERSION)
+
+// Light modules required around the symbol
+#define QR_QUIET_ZONE 4
+
+// Error correction level; roughly 7%, 15%, 25% and 30% of the symbol can be
+// damaged and still read
+enum QrEcc {
+  QR_ECC_LOW,
+  QR_ECC_MEDIUM,
+  QR_ECC_QUARTILE,
+  QR_ECC_HIGH,
+};
+
+struct QrCode {
+  int version;
+  int size; // modules per side
+  QrEcc ecc;
+  int mask;
+  uint64_t rows[QR_MAX_SIZE]; // bit x of rows[y] is set for a dark module
+};
+
+// Encode text (as bytes; numeric or alphanumeric mode is used when every
+// character allows it) in the smallest version that holds it at `ecc`.
+// mask is 0-7, or -1 to pick the mask with the lowest penalty score. Returns
+// false if the text does not fit in version 6.
+bool encodeQrCode(QrCode &qr, const char *text, QrEcc ecc, int mask = -1);
+
+inline bool qrModule(const QrCode &qr, int x, int y) {
+  return (qr.rows[y] >> x) & 1;
+}
+
+// Dots per side taken by the symbol and its quiet zone
+inline int qrCodeWidth(const QrCode &qr, int moduleSize) {
+  return (qr.size + 2 * QR_QUIET_ZONE) * moduleSize;
+}
+
+// Largest module size at which the symbol and its quiet zone fit in `extent`
+// dots; 0 if it does not fit at all
+inline int qrModuleSize(const QrCode &qr, int extent) {
+  return extent / qrCodeWidth(qr, 1);
+}
+
+// Draw the symbol with the top-left of its quiet zone at (x, y), each module
+// as a moduleSize x moduleSize block. Dark modules are set, light modules and
+// the quiet zone cleared.
+template <int W, int H>
+void drawQrCode(BasicBitmap<W, H> &bitmap, const QrCode &qr, int x, int y,
+                int moduleSize);
+template <int W, int H>
+void drawQrCode(PrinterBitmap<W, H> &bitmap, const QrCode &qr, int x, int y,
+                int moduleSize);
+
+#endif // QR_CODE_H
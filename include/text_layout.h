@@ -0,0 +1,100 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <font.h>
+#include <helper.h>
+
+// ============================================================================
+// TEXT LAYOUT
+// Line breaking, truncation and alignment computed from glyph metrics alone.
+// A TextLayout points into the caller's string (which must outlive it) and is
+// rasterized once with drawLayout() after it is final.
+// ============================================================================
+
+#define MAX_LAYOUT_LINES 8
+
+// Appended to lines that are cut short
+#define ELLIPSIS "..."
+
+enum TextAlign {
+  ALIGN_LEFT,
+  ALIGN_CENTER,
+  ALIGN_RIGHT,
+};
+
+struct TextBox {
+  int x;
+  int y;
+  int width;
+  int height;      // rows available; 0 = only MAX_LAYOUT_LINES limits lines
+  TextAlign align;
+  int lineSpacing; // extra rows between line boxes
+  bool wrap;       // break at spaces (or inside words that cannot fit)
+  bool ellipsis;   // end cut-short lines with ELLIPSIS
+};
+
+struct TextLine {
+  const char *start;
+  int length;    // bytes of the source string on this line
+  int x;         // pen x after alignment
+  int y;         // top of the line box
+  int width;     // ink width including the ellipsis
+  bool ellipsis; // ELLIPSIS follows the text
+};
+
+struct TextLayout {
+  const Font *font;
+  int scale; // glyph pixels are drawn scale x scale (see fitText)
+  TextLine lines[MAX_LAYOUT_LINES];
+  int lineCount;
+  int width;      // widest line
+  int height;     // rows from the top of the first line box to the last
+  bool truncated; // text was dropped or cut short to fit the box
+};
+
+// Columns from the pen start to the right edge of the last glyph's ink for
+// the first `length` bytes of str (all of it when length < 0)
+int textWidth(const Font &font, const char *str, int length = -1);
+
+// Rows taken by `lines` line boxes
+inline int textHeight(const Font &font, int lines, int lineSpacing = 0) {
+  return lines > 0 ? lines * font.height + (lines - 1) * lineSpacing : 0;
+}
+
+// Lay a UTF-8 string out in box ('\n' always starts a new line); returns the
+// line count
+int layoutText(TextLayout &layout, const Font &font, const char *str,
+               const TextBox &box);
+
+// ============================================================================
+// AUTO-FIT
+// Finds the largest text that fits a box by laying it out (never drawing) for
+// each candidate font and integer scale, binary-searching candidates ordered
+// by line height.
+// ============================================================================
+
+// Font and scale combinations considered by fitText
+#define MAX_FIT_CANDIDATES 32
+
+// Lay str out in box with the largest of fonts x scales at which nothing is
+// truncated; returns false when even the smallest does not fit (it is then
+// laid out truncated). Scales go up to what the box height allows. The text
+// block is centred vertically in the box, and box.lineSpacing is in font
+// rows, so it grows with the scale. Sizes that keep words whole win over
+// larger ones that would break a word across lines.
+bool fitText(TextLayout &layout, const Font *const *fonts, int fontCount,
+             const char *str, const TextBox &box);
+
+inline bool fitText(TextLayout &layout, const Font &font, const char *str,
+                    const TextBox &box) {
+  const Font *fonts[] = {&font};
+  return fitText(layout, fonts, 1, str, box);
+}
+
+// Draw every line of a finished layout
+template <int W, int H>
+void drawLayout(BasicBitmap<W, H> &bitmap, const TextLayout &layout);
+template <int W, int H>
+void drawLayout(PrinterBitmap<W, H> &bitmap, const TextLayout &layout);
+
+#endif // TEXT_LAYOUT_H
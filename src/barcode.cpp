@@ -0,0 +1,348 @@
+#include <barcode.h>
+#include <cstring>
+
+// ============================================================================
+// ELEMENT LIST
+// ============================================================================
+
+static void resetBarcode(Barcode &barcode, int quietLeft, int quietRight) {
+  barcode.count = 0;
+  barcode.modules = 0;
+  barcode.quietLeft = quietLeft;
+  barcode.quietRight = quietRight;
+}
+
+// Append elements given as a string of widths ('1'-'4')
+static bool appendWidths(Barcode &barcode, const char *widths) {
+  for (; *widths; widths++) {
+    if (barcode.count >= MAX_BARCODE_ELEMENTS) {
+      return false;
+    }
+    const int width = *widths - '0';
+    barcode.widths[barcode.count++] = width;
+    barcode.modules += width;
+  }
+  return true;
+}
+
+static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// ============================================================================
+// CODE 128
+// ============================================================================
+
+// Bar, space, bar, space, bar, space widths of symbol values 0-105
+static const char CODE128_PATTERNS[106][7] = {
+    "212222", "222122", "222221", "121223", "121322", "131222", "122213",
+    "122312", "132212", "221213", "221312", "231212", "112232", "122132",
+    "122231", "113222", "123122", "123221", "223211", "221132", "221231",
+    "213212", "223112", "312131", "311222", "321122", "321221", "312212",
+    "322112", "322211", "212123", "212321", "232121", "111323", "131123",
+    "131321", "112313", "132113", "132311", "211313", "231113", "231311",
+    "112133", "112331", "132131", "113123", "113321", "133121", "313121",
+    "211331", "231131", "213113", "213311", "213131", "311123", "311321",
+    "331121", "312113", "312311", "332111", "314111", "221411", "431111",
+    "111224", "111422", "121124", "121421", "141122", "141221", "112214",
+    "112412", "122114", "122411", "142112", "142211", "241211", "221114",
+    "413111", "241112", "134111", "111242", "121142", "121241", "114212",
+    "124112", "124211", "411212", "421112", "421211", "212141", "214121",
+    "412121", "111143", "111341", "131141", "114113", "114311", "411113",
+    "411311", "113141", "114131", "311141", "411131", "211412", "211214",
+    "211232",
+};
+
+// Stop pattern, including the final bar
+static const char CODE128_STOP[] = "2331112";
+
+enum Code128Symbol {
+  CODE128_SHIFT = 98,
+  CODE128_CODE_C = 99,
+  CODE128_CODE_B = 100,
+  CODE128_CODE_A = 101,
+  CODE128_START_A = 103,
+  CODE128_START_B = 104,
+  CODE128_START_C = 105,
+};
+
+enum Code128Set { SET_A, SET_B, SET_C };
+
+static bool inSetA(uint8_t c) { return c < 0x60; }
+static bool inSetB(uint8_t c) { return c >= 0x20 && c < 0x80; }
+
+static int valueInSet(uint8_t c, Code128Set set) {
+  if (set == SET_A && c < 0x20) {
+    return c + 64;
+  }
+  return c - 32;
+}
+
+static int digitRun(const char *text) {
+  int run = 0;
+  while (isDigit(text[run])) {
+    run++;
+  }
+  return run;
+}
+
+// Set A if a control character comes before any lower-case one, else B
+static Code128Set pickAOrB(const char *text) {
+  for (; *text; text++) {
+    const uint8_t c = *text;
+    if (c < 0x20) {
+      return SET_A;
+    }
+    if (c >= 0x60) {
+      return SET_B;
+    }
+  }
+  return SET_B;
+}
+
+// Symbol values accumulate with the weighted checksum
+struct Code128Writer {
+  Barcode &barcode;
+  int checksum;
+  int weight;
+  bool ok;
+
+  void put(int value) {
+    ok = ok && appendWidths(barcode, CODE128_PATTERNS[value]);
+    checksum += value * (weight ? weight : 1);
+    weight++;
+  }
+};
+
+bool encodeCode128(Barcode &barcode, const char *text) {
+  resetBarcode(barcode, 10, 10);
+  if (!*text) {
+    return false;
+  }
+  for (const char *p = text; *p; p++) {
+    if ((uint8_t)*p >= 0x80) {
+      return false;
+    }
+  }
+
+  Code128Writer out = {barcode, 0, 0, true};
+  const int leadingDigits = digitRun(text);
+  Code128Set set;
+  if (leadingDigits >= 4 || (leadingDigits == 2 && !text[2])) {
+    set = SET_C;
+    out.put(CODE128_START_C);
+  } else {
+    set = pickAOrB(text);
+    out.put(set == SET_A ? CODE128_START_A : CODE128_START_B);
+  }
+
+  const char *p = text;
+  while (*p && out.ok) {
+    if (set == SET_C) {
+      if (isDigit(p[0]) && isDigit(p[1])) {
+        out.put((p[0] - '0') * 10 + (p[1] - '0'));
+        p += 2;
+        continue;
+      }
+      set = pickAOrB(p);
+      out.put(set == SET_A ? CODE128_CODE_A : CODE128_CODE_B);
+      continue;
+    }
+
+    // Digit pairs pay for the CODE C switch from 4 digits at the end of the
+    // text, 6 in the middle
+    const int run = digitRun(p);
+    if (run >= (p[run] ? 6 : 4)) {
+      if (run & 1) {
+        out.put(valueInSet(*p, set));
+        p++;
+      }
+      set = SET_C;
+      out.put(CODE128_CODE_C);
+      continue;
+    }
+
+    const uint8_t c = *p;
+    const bool inSet = set == SET_A ? inSetA(c) : inSetB(c);
+    if (inSet) {
+      out.put(valueInSet(c, set));
+      p++;
+      continue;
+    }
+
+    // Switch for a run from the other set, SHIFT for a single character
+    const Code128Set other = set == SET_A ? SET_B : SET_A;
+    const uint8_t next = p[1];
+    if (next && !(set == SET_A ? inSetA(next) : inSetB(next))) {
+      set = other;
+      out.put(other == SET_A ? CODE128_CODE_A : CODE128_CODE_B);
+    } else {
+      out.put(CODE128_SHIFT);
+      out.put(valueInSet(c, other));
+      p++;
+    }
+  }
+
+  out.put(out.checksum % 103);
+  return out.ok && appendWidths(barcode, CODE128_STOP);
+}
+
+// ============================================================================
+// EAN-13 / UPC-A
+// ============================================================================
+
+// Space, bar, space, bar widths of the L (odd parity) digit codes. R codes
+// have the same widths starting with a bar; G codes are the R widths
+// reversed.
+static const char EAN_DIGITS[10][5] = {
+    "3211", "2221", "2122", "1411", "1132",
+    "1231", "1114", "1312", "1213", "3112",
+};
+
+// Per leading digit, which of the six left-hand digits use G codes (bit 5 is
+// the first digit)
+static const uint8_t EAN_PARITY[10] = {
+    0x00, 0x0B, 0x0D, 0x0E, 0x13, 0x19, 0x1C, 0x15, 0x16, 0x1A,
+};
+
+static int eanCheckDigit(const char *digits) {
+  int sum = 0;
+  for (int i = 0; i < 12; i++) {
+    sum += (digits[i] - '0') * ((i & 1) ? 3 : 1);
+  }
+  return (10 - sum % 10) % 10;
+}
+
+bool encodeEan13(Barcode &barcode, const char *digits) {
+  resetBarcode(barcode, 11, 7);
+  const int length = digitRun(digits);
+  if (digits[length] || (length != 12 && length != 13)) {
+    return false;
+  }
+  const int check = eanCheckDigit(digits);
+  if (length == 13 && digits[12] - '0' != check) {
+    return false;
+  }
+
+  const uint8_t parity = EAN_PARITY[digits[0] - '0'];
+  appendWidths(barcode, "111");
+  for (int i = 1; i <= 6; i++) {
+    const char *code = EAN_DIGITS[digits[i] - '0'];
+    if (parity & (0x20 >> (i - 1))) {
+      const char reversed[5] = {code[3], code[2], code[1], code[0], '\0'};
+      appendWidths(barcode, reversed);
+    } else {
+      appendWidths(barcode, code);
+    }
+  }
+  appendWidths(barcode, "11111");
+  for (int i = 7; i <= 12; i++) {
+    appendWidths(barcode, EAN_DIGITS[i < 12 ? digits[i] - '0' : check]);
+  }
+  appendWidths(barcode, "111");
+  return true;
+}
+
+bool encodeUpcA(Barcode &barcode, const char *digits) {
+  const int length = digitRun(digits);
+  if (digits[length] || (length != 11 && length != 12)) {
+    resetBarcode(barcode, 9, 9);
+    return false;
+  }
+  char ean[14] = "0";
+  memcpy(ean + 1, digits, length + 1);
+  if (!encodeEan13(barcode, ean)) {
+    return false;
+  }
+  barcode.quietLeft = 9;
+  barcode.quietRight = 9;
+  return true;
+}
+
+// ============================================================================
+// RENDERING
+// ============================================================================
+
+// Set bits [x1, x2) of a packed MSB-first row
+static void setRowBits(uint8_t *row, int x1, int x2) {
+  for (int x = x1; x < x2; x++) {
+    row[x >> 3] |= 0x80 >> (x & 7);
+  }
+}
+
+template <int W, int H>
+void drawBarcode(BasicBitmap<W, H> &bitmap, const Barcode &barcode, int x,
+                 int y1, int y2, int moduleWidth) {
+  const ClipRect &clip = bitmap.clip.rect;
+  int x1 = x;
+  int x2 = x + barcodeWidth(barcode, moduleWidth);
+  if (x1 < clip.x1)
+    x1 = clip.x1;
+  if (x2 > clip.x2)
+    x2 = clip.x2;
+  if (y1 < clip.y1)
+    y1 = clip.y1;
+  if (y2 > clip.y2)
+    y2 = clip.y2;
+  if (x1 >= x2 || y1 >= y2) {
+    return;
+  }
+
+  // One row of the symbol: bars in `bars`, everything written in `extent`
+  uint8_t bars[BasicBitmap<W, H>::STRIDE];
+  uint8_t extent[BasicBitmap<W, H>::STRIDE];
+  clearBuffer(bars, sizeof(bars));
+  clearBuffer(extent, sizeof(extent));
+  setRowBits(extent, x1, x2);
+
+  int pen = x + barcode.quietLeft * moduleWidth;
+  for (int i = 0; i < barcode.count; i++) {
+    const int end = pen + barcode.widths[i] * moduleWidth;
+    if (!(i & 1)) {
+      setRowBits(bars, pen < x1 ? x1 : pen, end > x2 ? x2 : end);
+    }
+    pen = end;
+  }
+
+  const int firstByte = x1 >> 3;
+  const int lastByte = (x2 - 1) >> 3;
+  for (int y = y1; y < y2; y++) {
+    uint8_t *row = bitmapRow(bitmap, y);
+    for (int b = firstByte; b <= lastByte; b++) {
+      row[b] = (row[b] & ~extent[b]) | bars[b];
+    }
+  }
+  markDirty(bitmap, x1, x2);
+}
+
+// fillColumnSpan writes whole 0xFF/0x00 column bytes between the end rows
+template <int W, int H>
+void drawBarcode(PrinterBitmap<W, H> &bitmap, const Barcode &barcode, int x,
+                 int y1, int y2, int moduleWidth) {
+  const int quietRight = barcode.quietRight * moduleWidth;
+  int pen = x;
+  for (int col = 0; col < barcode.quietLeft * moduleWidth; col++) {
+    fillColumnSpan(bitmap, pen++, y1, y2, false);
+  }
+  for (int i = 0; i < barcode.count; i++) {
+    const int width = barcode.widths[i] * moduleWidth;
+    for (int col = 0; col < width; col++) {
+      fillColumnSpan(bitmap, pen++, y1, y2, !(i & 1));
+    }
+  }
+  for (int col = 0; col < quietRight; col++) {
+    fillColumnSpan(bitmap, pen++, y1, y2, false);
+  }
+}
+
+// ============================================================================
+// EXPLICIT INSTANTIATIONS (one per tape canvas)
+// ============================================================================
+
+#define INSTANTIATE_BARCODE(W, H)                                              \
+  template void drawBarcode(BasicBitmap<W, H> &, const Barcode &, int, int,    \
+                            int, int);                                         \
+  template void drawBarcode(PrinterBitmap<W, H> &, const Barcode &, int, int,  \
+                            int, int);
+
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_BARCODE)
+
+#undef INSTANTIATE_BARCODE
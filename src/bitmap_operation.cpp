@@ -1,38 +1,39 @@
 #include <bitmap_operation.h>
+#include <cstring>
+#include <font.h>
 
 // ============================================================================
 // BIT REPRESENTATION:
 // - In memory: 0 = white, 1 = black (matches thermal printer)
 // - Pixel packing: MSB first (bit 7 = first pixel, bit 0 = last pixel)
-// - Coordinates: (0,0) = top-left, (383,95) = bottom-right
+// - Row layout: each row starts at y * STRIDE, padding bits past the canvas
+//   width are don't-care
+// - Coordinates: (0,0) = top-left, (W-1,H-1) = bottom-right
 // ============================================================================
 
 // ============================================================================
 // BITMAP CREATION (Returns new bitmap)
 // ============================================================================
 
-Bitmap *createEmptyBitmapPtr() {
-  Bitmap *bmp = new (std::nothrow) Bitmap();
+template <int W, int H> BasicBitmap<W, H> *createEmptyBitmapPtr() {
+  BasicBitmap<W, H> *bmp = new (std::nothrow) BasicBitmap<W, H>();
   if (!bmp)
     return nullptr;
-  clearBuffer(bmp->data, BITMAP_SIZE);
+  clearBuffer(bmp->data, BasicBitmap<W, H>::SIZE);
   return bmp;
 }
 
 // Create empty bitmap (all white - 0x00)
-Bitmap createEmptyBitmap() {
-  Bitmap bitmap;
-  clearBuffer(bitmap.data, BITMAP_SIZE);
+template <int W, int H> BasicBitmap<W, H> createEmptyBitmap() {
+  BasicBitmap<W, H> bitmap;
+  clearBuffer(bitmap.data, BasicBitmap<W, H>::SIZE);
   return bitmap;
 }
 
 // Create filled bitmap (0xFF = black, 0x00 = white)
-Bitmap createFilledBitmap(bool black) {
-  Bitmap bitmap;
-  const uint8_t fillValue = black ? 0xFF : 0x00;
-  for (size_t i = 0; i < BITMAP_SIZE; i++) {
-    bitmap.data[i] = fillValue;
-  }
+template <int W, int H> BasicBitmap<W, H> createFilledBitmap(bool black) {
+  BasicBitmap<W, H> bitmap;
+  fillBitmap(bitmap, black);
   return bitmap;
 }
 
@@ -40,143 +41,219 @@ Bitmap createFilledBitmap(bool black) {
 // IN-PLACE OPERATIONS (Modify bitmap directly, no copies)
 // ============================================================================
 
-void setPixel(Bitmap &bitmap, int x, int y, bool black) {
-  if (x < 0 || x >= IMAGE_WIDTH || y < 0 || y >= IMAGE_HEIGHT) {
-    return;
-  }
-
-  const int idx = pixelToIndex(x, y);
-  const int byteIdx = indexToByte(idx);
-  const int bitPos = indexToBit(idx);
-  const uint8_t mask = bitMask(bitPos);
+// Set pixel (x, y) with no clip or bounds check; callers clip first and mark
+// the columns they touched dirty
+template <int W, int H>
+static inline void plotPixel(BasicBitmap<W, H> &bitmap, int x, int y) {
+  bitmapRow(bitmap, y)[x >> 3] |= 0x80 >> (x & 7);
+}
 
-  // Defensive: ensure we don't write beyond allocated buffer
-  if (!isValidByteIndex(byteIdx)) {
-    // In debug builds assert to catch logic errors; in production just return
-    assert(false && "byteIdx out of range in setPixel");
+// The clip rectangle lies inside the canvas, so one test against it covers
+// both the drawing region and the buffer bounds
+template <int W, int H>
+void setPixel(BasicBitmap<W, H> &bitmap, int x, int y, bool black) {
+  if (!clipContains(bitmap, x, y)) {
     return;
   }
 
+  const uint8_t mask = 0x80 >> (x & 7);
   if (black) {
-    bitmap.data[byteIdx] |= mask;
+    bitmapRow(bitmap, y)[x >> 3] |= mask;
   } else {
-    bitmap.data[byteIdx] &= ~mask;
+    bitmapRow(bitmap, y)[x >> 3] &= ~mask;
   }
+  markDirty(bitmap, x, x + 1);
 }
 
 // Clear pixel (helper for convenience)
-void clearPixel(Bitmap &bitmap, int x, int y) { setPixel(bitmap, x, y, false); }
+template <int W, int H>
+void clearPixel(BasicBitmap<W, H> &bitmap, int x, int y) {
+  setPixel(bitmap, x, y, false);
+}
 
-void fillBitmap(Bitmap &bitmap, bool black) {
-  const uint8_t fillValue = black ? 0xFF : 0x00;
-  for (size_t i = 0; i < BITMAP_SIZE; i++) {
-    bitmap.data[i] = fillValue;
+template <int W, int H>
+void fillBitmap(BasicBitmap<W, H> &bitmap, bool black) {
+  if (!clipIsCanvas(bitmap)) {
+    const ClipRect &clip = bitmap.clip.rect;
+    for (int y = clip.y1; y < clip.y2; y++) {
+      fillSpan(bitmap, y, clip.x1, clip.x2, black);
+    }
+    return;
   }
+  fillBuffer(bitmap.data, BasicBitmap<W, H>::SIZE, black ? 0xFF : 0x00);
+  markAllDirty(bitmap);
 }
 
-// Clear entire bitmap (convenience wrapper)
-void clearBitmap(Bitmap &bitmap) { clearBuffer(bitmap.data, BITMAP_SIZE); }
-
-// Apply function to all pixels in range (modifies in place)
-void mapPixels(Bitmap &bitmap, int x1, int y1, int x2, int y2,
-               std::function<bool(int, int)> predicate) {
-  for (int y = y1; y < y2; y++) {
-    for (int x = x1; x < x2; x++) {
-      if (predicate(x, y)) {
-        setPixel(bitmap, x, y, true);
-      }
-    }
+// Merge the bits selected by mask into a single byte
+static inline void writeMasked(uint8_t &byte, uint8_t mask, bool black) {
+  if (black) {
+    byte |= mask;
+  } else {
+    byte &= ~mask;
   }
 }
 
-void drawBorder(Bitmap &bitmap, int thickness) {
-  // Use setPixel for consistency
-  // Top border
-  for (int y = 0; y < thickness; y++) {
-    for (int x = 0; x < IMAGE_WIDTH; x++) {
-      setPixel(bitmap, x, y, true);
-    }
+// Fill the horizontal run [x1, x2) on row y. The run is clipped once, then
+// written as a masked leading byte, whole bytes in between (memset, which
+// stores aligned 32-bit words) and a masked trailing byte.
+template <int W, int H>
+void fillSpan(BasicBitmap<W, H> &bitmap, int y, int x1, int x2, bool black) {
+  const ClipRect &clip = bitmap.clip.rect;
+  if (y < clip.y1 || y >= clip.y2) {
+    return;
+  }
+  if (x1 < clip.x1)
+    x1 = clip.x1;
+  if (x2 > clip.x2)
+    x2 = clip.x2;
+  if (x1 >= x2) {
+    return;
   }
 
-  // Bottom border
-  for (int y = IMAGE_HEIGHT - thickness; y < IMAGE_HEIGHT; y++) {
-    for (int x = 0; x < IMAGE_WIDTH; x++) {
-      setPixel(bitmap, x, y, true);
-    }
+  markDirty(bitmap, x1, x2);
+
+  uint8_t *row = bitmapRow(bitmap, y);
+  const int firstByte = x1 >> 3;
+  const int lastByte = (x2 - 1) >> 3;
+  const uint8_t headMask = 0xFF >> (x1 & 7);
+  const uint8_t tailMask = 0xFF << (7 - ((x2 - 1) & 7));
+
+  if (firstByte == lastByte) {
+    writeMasked(row[firstByte], headMask & tailMask, black);
+    return;
   }
 
-  // Left border
-  for (int y = thickness; y < IMAGE_HEIGHT - thickness; y++) {
-    for (int x = 0; x < thickness; x++) {
-      setPixel(bitmap, x, y, true);
-    }
+  writeMasked(row[firstByte], headMask, black);
+  if (lastByte - firstByte > 1) {
+    memset(row + firstByte + 1, black ? 0xFF : 0x00,
+           lastByte - firstByte - 1);
   }
+  writeMasked(row[lastByte], tailMask, black);
+}
 
-  // Right border
-  for (int y = thickness; y < IMAGE_HEIGHT - thickness; y++) {
-    for (int x = IMAGE_WIDTH - thickness; x < IMAGE_WIDTH; x++) {
-      setPixel(bitmap, x, y, true);
+// Fill whole rows [y1, y2) in one bulk fill (rows are contiguous), or row by
+// row when the clip cuts them short
+template <int W, int H>
+static void fillRows(BasicBitmap<W, H> &bitmap, int y1, int y2,
+                     bool black) {
+  const ClipRect &clip = bitmap.clip.rect;
+  if (y1 < clip.y1)
+    y1 = clip.y1;
+  if (y2 > clip.y2)
+    y2 = clip.y2;
+  if (y1 >= y2) {
+    return;
+  }
+  if (clip.x1 != 0 || clip.x2 != W) {
+    for (int y = y1; y < y2; y++) {
+      fillSpan(bitmap, y, clip.x1, clip.x2, black);
     }
+    return;
   }
+  fillBuffer(bitmapRow(bitmap, y1), (y2 - y1) * BasicBitmap<W, H>::STRIDE,
+             black ? 0xFF : 0x00);
+  markAllDirty(bitmap);
 }
 
-void drawDiagonals(Bitmap &bitmap) {
-  const int minDim = (IMAGE_WIDTH < IMAGE_HEIGHT) ? IMAGE_WIDTH : IMAGE_HEIGHT;
+// Clear entire bitmap (convenience wrapper)
+template <int W, int H>
+void clearBitmap(BasicBitmap<W, H> &bitmap) {
+  if (!clipIsCanvas(bitmap)) {
+    fillBitmap(bitmap, false);
+    return;
+  }
+  clearBuffer(bitmap.data, BasicBitmap<W, H>::SIZE);
+  markAllDirty(bitmap);
+}
 
-  for (int i = 0; i < minDim; i++) {
-    // Main diagonal (top-left to bottom-right)
-    setPixel(bitmap, i, i, true);
+// Apply function to all pixels in range (modifies in place)
+template <int W, int H>
+void mapPixels(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2,
+               std::function<bool(int, int)> predicate) {
+  // Still one indirect call per pixel, but the row writes are batched
+  mapPixels<W, H, const std::function<bool(int, int)> &>(bitmap, x1, y1, x2,
+                                                          y2, predicate);
+}
 
-    // Anti-diagonal (top-right to bottom-left)
-    setPixel(bitmap, IMAGE_WIDTH - 1 - i, i, true);
+template <int W, int H>
+void drawBorder(BasicBitmap<W, H> &bitmap, int thickness) {
+  // Top and bottom borders are whole rows
+  fillRows(bitmap, 0, thickness, true);
+  fillRows(bitmap, H - thickness, H, true);
+
+  // Left and right borders are two short spans per remaining row
+  for (int y = thickness; y < H - thickness; y++) {
+    fillSpan(bitmap, y, 0, thickness, true);
+    fillSpan(bitmap, y, W - thickness, W, true);
   }
 }
 
-// Draw character at position (modifies in place)
-void drawChar(Bitmap &bitmap, char c, int startX, int startY) {
-  static const uint8_t font[10][7] = {
-      {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 0
-      {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 1
-      {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // 2
-      {0x0E, 0x11, 0x01, 0x06, 0x01, 0x11, 0x0E}, // 3
-      {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // 4
-      {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // 5
-      {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // 6
-      {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // 7
-      {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // 8
-      {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // 9
-  };
+template <int W, int H>
+void drawDiagonals(BasicBitmap<W, H> &bitmap) {
+  const ClipRect &clip = bitmap.clip.rect;
+  const int minDim = (W < H) ? W : H;
 
-  if (c < '0' || c > '9') {
-    return;
+  // Main diagonal (top-left to bottom-right): pixel (i, i)
+  int first = clip.x1 > clip.y1 ? clip.x1 : clip.y1;
+  int last = clip.x2 < clip.y2 ? clip.x2 : clip.y2;
+  if (last > minDim)
+    last = minDim;
+  for (int i = first; i < last; i++) {
+    plotPixel(bitmap, i, i);
   }
+  markDirty(bitmap, first, last);
 
-  const int digit = c - '0';
-
-  for (int row = 0; row < 7; row++) {
-    for (int col = 0; col < 5; col++) {
-      if (font[digit][row] & (1 << (4 - col))) {
-        const int x = startX + col;
-        const int y = startY + row;
-        if (x >= 0 && x < IMAGE_WIDTH && y >= 0 && y < IMAGE_HEIGHT) {
-          const int idx = pixelToIndex(x, y);
-          bitmap.data[indexToByte(idx)] |= bitMask(indexToBit(idx));
-        }
-      }
-    }
+  // Anti-diagonal (top-right to bottom-left): pixel (W - 1 - i, i)
+  first = W - clip.x2 > clip.y1 ? W - clip.x2 : clip.y1;
+  last = W - clip.x1 < clip.y2 ? W - clip.x1 : clip.y2;
+  if (last > minDim)
+    last = minDim;
+  for (int i = first; i < last; i++) {
+    plotPixel(bitmap, W - 1 - i, i);
   }
+  markDirty(bitmap, W - last, W - first);
+}
+
+// Text goes through the font engine (font.h) with the default font
+template <int W, int H>
+void drawChar(BasicBitmap<W, H> &bitmap, char c, int startX, int startY) {
+  drawGlyph(bitmap, DEFAULT_FONT, (uint8_t)c, startX, startY);
 }
 
-void drawString(Bitmap &bitmap, const char *str, int startX, int startY) {
-  int x = startX;
-  while (*str) {
-    drawChar(bitmap, *str, x, startY);
-    x += 6; // 5 pixels wide + 1 pixel spacing
-    str++;
+template <int W, int H>
+void drawString(BasicBitmap<W, H> &bitmap, const char *str, int startX,
+                int startY) {
+  drawText(bitmap, DEFAULT_FONT, str, startX, startY);
+}
+
+// Set the half-open vertical run [y1, y2) in column x, clipped once
+template <int W, int H>
+static void fillVerticalRun(BasicBitmap<W, H> &bitmap, int x, int y1,
+                            int y2) {
+  const ClipRect &clip = bitmap.clip.rect;
+  if (x < clip.x1 || x >= clip.x2) {
+    return;
+  }
+  if (y1 < clip.y1)
+    y1 = clip.y1;
+  if (y2 > clip.y2)
+    y2 = clip.y2;
+  if (y1 >= y2) {
+    return;
+  }
+
+  markDirty(bitmap, x, x + 1);
+
+  uint8_t *p = bitmapRow(bitmap, y1) + (x >> 3);
+  const uint8_t mask = 0x80 >> (x & 7);
+  for (int y = y1; y < y2; y++) {
+    *p |= mask;
+    p += BasicBitmap<W, H>::STRIDE;
   }
 }
 
-void drawRect(Bitmap &bitmap, int x1, int y1, int x2, int y2) {
+template <int W, int H>
+void drawRect(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2) {
   // Ensure coordinates are in order
   if (x1 > x2) {
     int temp = x1;
@@ -190,19 +267,16 @@ void drawRect(Bitmap &bitmap, int x1, int y1, int x2, int y2) {
   }
 
   // Top and bottom edges
-  for (int x = x1; x <= x2; x++) {
-    setPixel(bitmap, x, y1, true);
-    setPixel(bitmap, x, y2, true);
-  }
+  fillSpan(bitmap, y1, x1, x2 + 1, true);
+  fillSpan(bitmap, y2, x1, x2 + 1, true);
 
   // Left and right edges
-  for (int y = y1; y <= y2; y++) {
-    setPixel(bitmap, x1, y, true);
-    setPixel(bitmap, x2, y, true);
-  }
+  fillVerticalRun(bitmap, x1, y1, y2 + 1);
+  fillVerticalRun(bitmap, x2, y1, y2 + 1);
 }
 
-void fillRect(Bitmap &bitmap, int x1, int y1, int x2, int y2) {
+template <int W, int H>
+void fillRect(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2) {
   // Ensure coordinates are in order
   if (x1 > x2) {
     int temp = x1;
@@ -216,13 +290,13 @@ void fillRect(Bitmap &bitmap, int x1, int y1, int x2, int y2) {
   }
 
   for (int y = y1; y <= y2; y++) {
-    for (int x = x1; x <= x2; x++) {
-      setPixel(bitmap, x, y, true);
-    }
+    fillSpan(bitmap, y, x1, x2 + 1, true);
   }
 }
 
-void drawLine(Bitmap &bitmap, int x0, int y0, int x1, int y1) {
+// Bresenham from (x0, y0) to (x1, y1), handing each point to plot
+template <typename Plot>
+static void traceLine(int x0, int y0, int x1, int y1, Plot plot) {
   int dx = abs(x1 - x0);
   int dy = abs(y1 - y0);
   int sx = (x0 < x1) ? 1 : -1;
@@ -230,7 +304,7 @@ void drawLine(Bitmap &bitmap, int x0, int y0, int x1, int y1) {
   int err = dx - dy;
 
   while (true) {
-    setPixel(bitmap, x0, y0, true);
+    plot(x0, y0);
 
     if (x0 == x1 && y0 == y1)
       break;
@@ -247,20 +321,48 @@ void drawLine(Bitmap &bitmap, int x0, int y0, int x1, int y1) {
   }
 }
 
-void drawCircle(Bitmap &bitmap, int centerX, int centerY, int radius) {
+// Shapes whose bounding box [x1, x2) x [y1, y2) is inside the clip (the usual
+// case) are plotted unchecked; others test each point against the clip.
+template <int W, int H>
+static bool boxInsideClip(const BasicBitmap<W, H> &bitmap, int x1, int y1,
+                          int x2, int y2) {
+  const ClipRect &clip = bitmap.clip.rect;
+  return x1 >= clip.x1 && x2 <= clip.x2 && y1 >= clip.y1 && y2 <= clip.y2;
+}
+
+template <int W, int H>
+void drawLine(BasicBitmap<W, H> &bitmap, int x0, int y0, int x1, int y1) {
+  const int left = x0 < x1 ? x0 : x1;
+  const int right = x0 < x1 ? x1 : x0;
+  const int top = y0 < y1 ? y0 : y1;
+  const int bottom = y0 < y1 ? y1 : y0;
+
+  if (boxInsideClip(bitmap, left, top, right + 1, bottom + 1)) {
+    markDirty(bitmap, left, right + 1);
+    traceLine(x0, y0, x1, y1,
+              [&bitmap](int x, int y) { plotPixel(bitmap, x, y); });
+    return;
+  }
+  traceLine(x0, y0, x1, y1,
+            [&bitmap](int x, int y) { setPixel(bitmap, x, y, true); });
+}
+
+// Midpoint circle outline, handing each of the eight octant points to plot
+template <typename Plot>
+static void traceCircle(int centerX, int centerY, int radius, Plot plot) {
   int x = radius;
   int y = 0;
   int err = 0;
 
   while (x >= y) {
-    setPixel(bitmap, centerX + x, centerY + y, true);
-    setPixel(bitmap, centerX + y, centerY + x, true);
-    setPixel(bitmap, centerX - y, centerY + x, true);
-    setPixel(bitmap, centerX - x, centerY + y, true);
-    setPixel(bitmap, centerX - x, centerY - y, true);
-    setPixel(bitmap, centerX - y, centerY - x, true);
-    setPixel(bitmap, centerX + y, centerY - x, true);
-    setPixel(bitmap, centerX + x, centerY - y, true);
+    plot(centerX + x, centerY + y);
+    plot(centerX + y, centerY + x);
+    plot(centerX - y, centerY + x);
+    plot(centerX - x, centerY + y);
+    plot(centerX - x, centerY - y);
+    plot(centerX - y, centerY - x);
+    plot(centerX + y, centerY - x);
+    plot(centerX + x, centerY - y);
 
     if (err <= 0) {
       y += 1;
@@ -273,48 +375,324 @@ void drawCircle(Bitmap &bitmap, int centerX, int centerY, int radius) {
   }
 }
 
-void fillCircle(Bitmap &bitmap, int centerX, int centerY, int radius) {
-  for (int y = -radius; y <= radius; y++) {
-    for (int x = -radius; x <= radius; x++) {
-      if (x * x + y * y <= radius * radius) {
-        setPixel(bitmap, centerX + x, centerY + y, true);
+template <int W, int H>
+void drawCircle(BasicBitmap<W, H> &bitmap, int centerX, int centerY,
+                int radius) {
+  if (radius < 0) {
+    return;
+  }
+
+  if (boxInsideClip(bitmap, centerX - radius, centerY - radius,
+                    centerX + radius + 1, centerY + radius + 1)) {
+    markDirty(bitmap, centerX - radius, centerX + radius + 1);
+    traceCircle(centerX, centerY, radius,
+                [&bitmap](int x, int y) { plotPixel(bitmap, x, y); });
+    return;
+  }
+  traceCircle(centerX, centerY, radius, [&bitmap](int x, int y) {
+    setPixel(bitmap, x, y, true);
+  });
+}
+
+// Half-width of a disc of radius r on the row dy rows from its centre: the
+// largest x with x^2 + dy^2 <= r^2. Rows are visited with growing dy, so x
+// only ever steps inwards and a whole disc costs O(r) steps (midpoint walk).
+static inline int discHalfWidth(int &x, int dy, int r) {
+  while (x >= 0 && x * x + dy * dy > r * r)
+    x--;
+  return x;
+}
+
+// Fill the inclusive span [x1, x2] on row y
+template <int W, int H>
+static inline void fillRowSpan(BasicBitmap<W, H> &bitmap, int y, int x1,
+                               int x2) {
+  fillSpan(bitmap, y, x1, x2 + 1, true);
+}
+
+template <int W, int H>
+void fillCircle(BasicBitmap<W, H> &bitmap, int centerX, int centerY,
+                int radius) {
+  if (radius < 0) {
+    return;
+  }
+
+  int x = radius;
+  for (int dy = 0; dy <= radius; dy++) {
+    const int half = discHalfWidth(x, dy, radius);
+    fillRowSpan(bitmap, centerY + dy, centerX - half, centerX + half);
+    if (dy != 0)
+      fillRowSpan(bitmap, centerY - dy, centerX - half, centerX + half);
+  }
+}
+
+template <int W, int H>
+void fillEllipse(BasicBitmap<W, H> &bitmap, int centerX, int centerY,
+                 int radiusX, int radiusY) {
+  if (radiusX < 0 || radiusY < 0) {
+    return;
+  }
+
+  // Inside when x^2 * ry^2 + y^2 * rx^2 <= rx^2 * ry^2 (64-bit: the products
+  // overflow int for ellipses wider than the canvas is tall)
+  const int64_t rx2 = (int64_t)radiusX * radiusX;
+  const int64_t ry2 = (int64_t)radiusY * radiusY;
+  const int64_t limit = rx2 * ry2;
+
+  int x = radiusX;
+  for (int dy = 0; dy <= radiusY; dy++) {
+    while (x >= 0 && x * x * ry2 + dy * dy * rx2 > limit)
+      x--;
+    fillRowSpan(bitmap, centerY + dy, centerX - x, centerX + x);
+    if (dy != 0)
+      fillRowSpan(bitmap, centerY - dy, centerX - x, centerX + x);
+  }
+}
+
+template <int W, int H>
+void fillRing(BasicBitmap<W, H> &bitmap, int centerX, int centerY,
+              int innerRadius, int outerRadius) {
+  if (outerRadius < 0) {
+    return;
+  }
+  if (innerRadius < 0) {
+    fillCircle(bitmap, centerX, centerY, outerRadius);
+    return;
+  }
+
+  int outerX = outerRadius;
+  int innerX = innerRadius;
+  for (int dy = 0; dy <= outerRadius; dy++) {
+    const int outer = discHalfWidth(outerX, dy, outerRadius);
+    // Rows past the hole (or rows where it is empty) are one solid span
+    const int inner =
+        (dy <= innerRadius) ? discHalfWidth(innerX, dy, innerRadius) : -1;
+    for (int side = 0; side < 2; side++) {
+      const int y = side ? centerY - dy : centerY + dy;
+      if (side && dy == 0)
+        break;
+      if (inner < 0) {
+        fillRowSpan(bitmap, y, centerX - outer, centerX + outer);
+      } else if (inner < outer) {
+        fillRowSpan(bitmap, y, centerX - outer, centerX - inner - 1);
+        fillRowSpan(bitmap, y, centerX + inner + 1, centerX + outer);
       }
     }
   }
 }
 
-void invertBitmap(Bitmap &bitmap) {
-  for (int i = 0; i < BITMAP_SIZE; i++) {
-    bitmap.data[i] ^= 0xFF;
+template <int W, int H>
+void fillRoundRect(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2,
+                   int radius) {
+  if (x1 > x2) {
+    int temp = x1;
+    x1 = x2;
+    x2 = temp;
+  }
+  if (y1 > y2) {
+    int temp = y1;
+    y1 = y2;
+    y2 = temp;
+  }
+
+  // Corners may not overlap
+  const int maxRadius = ((x2 - x1 < y2 - y1) ? x2 - x1 : y2 - y1) / 2;
+  if (radius > maxRadius)
+    radius = maxRadius;
+  if (radius < 0)
+    radius = 0;
+
+  // Straight middle band
+  for (int y = y1 + radius; y <= y2 - radius; y++) {
+    fillRowSpan(bitmap, y, x1, x2);
+  }
+
+  // Top and bottom bands, one span per row between the corner arcs
+  int x = radius;
+  for (int dy = 1; dy <= radius; dy++) {
+    const int half = discHalfWidth(x, dy, radius);
+    const int left = x1 + radius - half;
+    const int right = x2 - radius + half;
+    fillRowSpan(bitmap, y1 + radius - dy, left, right);
+    fillRowSpan(bitmap, y2 - radius + dy, left, right);
   }
 }
 
-void copyBitmap(Bitmap &dest, const Bitmap &src) {
-  copyBuffer(dest.data, src.data, BITMAP_SIZE);
+template <int W, int H>
+void invertBitmap(BasicBitmap<W, H> &bitmap) {
+  invertBuffer(bitmap.data, BasicBitmap<W, H>::SIZE);
+  markAllDirty(bitmap);
 }
 
-void drawGrid(Bitmap &bitmap, int spacing) {
-  // Vertical lines
-  for (int x = 0; x < IMAGE_WIDTH; x += spacing) {
-    for (int y = 0; y < IMAGE_HEIGHT; y++) {
-      setPixel(bitmap, x, y, true);
+template <int W, int H>
+void copyBitmap(BasicBitmap<W, H> &dest, const BasicBitmap<W, H> &src) {
+  copyBuffer(dest.data, src.data, BasicBitmap<W, H>::SIZE);
+  markAllDirty(dest);
+}
+
+template <int W, int H>
+void drawGrid(BasicBitmap<W, H> &bitmap, int spacing) {
+  if (spacing <= 0) {
+    return;
+  }
+
+  for (int y = 0; y < H; y++) {
+    if (y % spacing == 0) {
+      // Horizontal line covers the whole row
+      fillSpan(bitmap, y, 0, W, true);
+      continue;
+    }
+    // Vertical lines cross this row as single-pixel spans
+    for (int x = 0; x < W; x += spacing) {
+      fillSpan(bitmap, y, x, x + 1, true);
     }
   }
+}
 
-  // Horizontal lines
-  for (int y = 0; y < IMAGE_HEIGHT; y += spacing) {
-    for (int x = 0; x < IMAGE_WIDTH; x++) {
-      setPixel(bitmap, x, y, true);
+template <int W, int H>
+void drawCheckerboard(BasicBitmap<W, H> &bitmap, int squareSize) {
+  if (squareSize <= 0) {
+    return;
+  }
+
+  // Each row alternates black and white runs of squareSize pixels
+  for (int y = 0; y < H; y++) {
+    bool black = (y / squareSize) % 2 == 0;
+    for (int x = 0; x < W; x += squareSize) {
+      fillSpan(bitmap, y, x, x + squareSize, black);
+      black = !black;
     }
   }
 }
 
-void drawCheckerboard(Bitmap &bitmap, int squareSize) {
-  for (int y = 0; y < IMAGE_HEIGHT; y++) {
-    for (int x = 0; x < IMAGE_WIDTH; x++) {
-      bool shouldDraw = ((x / squareSize) + (y / squareSize)) % 2 == 0;
-      setPixel(bitmap, x, y, shouldDraw);
+// ============================================================================
+// BLIT (raster operations, shift-and-merge one destination byte at a time)
+// ============================================================================
+
+template <RasterOp Op> static inline uint8_t applyRop(uint8_t dst, uint8_t src);
+template <> inline uint8_t applyRop<ROP_COPY>(uint8_t, uint8_t src) {
+  return src;
+}
+template <> inline uint8_t applyRop<ROP_OR>(uint8_t dst, uint8_t src) {
+  return dst | src;
+}
+template <> inline uint8_t applyRop<ROP_AND>(uint8_t dst, uint8_t src) {
+  return dst & src;
+}
+template <> inline uint8_t applyRop<ROP_XOR>(uint8_t dst, uint8_t src) {
+  return dst ^ src;
+}
+template <> inline uint8_t applyRop<ROP_ANDNOT>(uint8_t dst, uint8_t src) {
+  return dst & ~src;
+}
+
+// Blend `width` source bits starting at bit srcX of srcRow into destRow
+// starting at bit destX. Each destination byte takes the 8 source bits
+// aligned to it from a two-byte window, so the shift is the same for the
+// whole row and bits are never touched one at a time.
+template <RasterOp Op>
+static void blitRow(uint8_t *destRow, int destX, const uint8_t *srcRow,
+                    int srcRowBytes, int srcX, int width) {
+  const int firstByte = destX >> 3;
+  const int lastByte = (destX + width - 1) >> 3;
+  const uint8_t headMask = 0xFF >> (destX & 7);
+  const uint8_t tailMask = 0xFF << (7 - ((destX + width - 1) & 7));
+
+  // Source bit aligned with bit 0 of firstByte; may start up to 7 bits
+  // before the row, those bits are masked off by headMask
+  const int offset = srcX - (destX & 7);
+  const int shift = offset & 7;
+  int q = offset >> 3;
+
+  for (int j = firstByte; j <= lastByte; j++, q++) {
+    const uint8_t hi = (q >= 0 && q < srcRowBytes) ? srcRow[q] : 0;
+    uint8_t bits = hi;
+    if (shift) {
+      const uint8_t lo = (q + 1 < srcRowBytes) ? srcRow[q + 1] : 0;
+      bits = (hi << shift) | (lo >> (8 - shift));
     }
+
+    uint8_t mask = 0xFF;
+    if (j == firstByte)
+      mask &= headMask;
+    if (j == lastByte)
+      mask &= tailMask;
+
+    const uint8_t old = destRow[j];
+    destRow[j] = (old & ~mask) | (applyRop<Op>(old, bits) & mask);
+  }
+}
+
+template <RasterOp Op, int W, int H>
+static void blitRows(BasicBitmap<W, H> &dest, int destX, int destY,
+                     const BitmapView &src, int srcX, int srcY, int width,
+                     int height) {
+  const int srcRowBytes = (src.width + 7) >> 3;
+  for (int row = 0; row < height; row++) {
+    blitRow<Op>(bitmapRow(dest, destY + row), destX,
+                src.data + (srcY + row) * src.stride, srcRowBytes, srcX,
+                width);
+  }
+}
+
+template <int W, int H>
+void blit(BasicBitmap<W, H> &dest, int destX, int destY, const BitmapView &src,
+          int srcX, int srcY, int width, int height, RasterOp op) {
+  // Clip once against the source...
+  if (srcX < 0) {
+    destX -= srcX;
+    width += srcX;
+    srcX = 0;
+  }
+  if (srcY < 0) {
+    destY -= srcY;
+    height += srcY;
+    srcY = 0;
+  }
+  if (srcX + width > src.width)
+    width = src.width - srcX;
+  if (srcY + height > src.height)
+    height = src.height - srcY;
+
+  // ...and the destination clip
+  const ClipRect &clip = dest.clip.rect;
+  if (destX < clip.x1) {
+    srcX += clip.x1 - destX;
+    width -= clip.x1 - destX;
+    destX = clip.x1;
+  }
+  if (destY < clip.y1) {
+    srcY += clip.y1 - destY;
+    height -= clip.y1 - destY;
+    destY = clip.y1;
+  }
+  if (destX + width > clip.x2)
+    width = clip.x2 - destX;
+  if (destY + height > clip.y2)
+    height = clip.y2 - destY;
+
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+
+  markDirty(dest, destX, destX + width);
+
+  switch (op) {
+  case ROP_COPY:
+    blitRows<ROP_COPY>(dest, destX, destY, src, srcX, srcY, width, height);
+    break;
+  case ROP_OR:
+    blitRows<ROP_OR>(dest, destX, destY, src, srcX, srcY, width, height);
+    break;
+  case ROP_AND:
+    blitRows<ROP_AND>(dest, destX, destY, src, srcX, srcY, width, height);
+    break;
+  case ROP_XOR:
+    blitRows<ROP_XOR>(dest, destX, destY, src, srcX, srcY, width, height);
+    break;
+  case ROP_ANDNOT:
+    blitRows<ROP_ANDNOT>(dest, destX, destY, src, srcX, srcY, width, height);
+    break;
   }
 }
 
@@ -322,8 +700,11 @@ void drawCheckerboard(Bitmap &bitmap, int squareSize) {
 // COMPOSE FUNCTION (Modified to work with in-place operations)
 // ============================================================================
 
-void compose(Bitmap &bitmap, void (*f1)(Bitmap &), void (*f2)(Bitmap &),
-             void (*f3)(Bitmap &)) {
+template <int W, int H>
+void compose(BasicBitmap<W, H> &bitmap,
+             typename BasicBitmap<W, H>::Operation f1,
+             typename BasicBitmap<W, H>::Operation f2,
+             typename BasicBitmap<W, H>::Operation f3) {
   if (f1)
     f1(bitmap);
   if (f2)
@@ -331,3 +712,554 @@ void compose(Bitmap &bitmap, void (*f1)(Bitmap &), void (*f2)(Bitmap &),
   if (f3)
     f3(bitmap);
 }
+
+// ============================================================================
+// PRINTER-FORMAT CANVAS
+// Row y of column x is bit (0x80 >> (y % 8)) of byte (y / 8) ^ 1. As
+// little-endian 16-bit words a column reads top row first, MSB first.
+// ============================================================================
+
+template <int W, int H> PrinterBitmap<W, H> *createEmptyPrinterBitmapPtr() {
+  PrinterBitmap<W, H> *bmp = new (std::nothrow) PrinterBitmap<W, H>();
+  if (!bmp)
+    return nullptr;
+  clearBuffer(bmp->data, PrinterBitmap<W, H>::SIZE);
+  return bmp;
+}
+
+template <int W, int H>
+void setPixel(PrinterBitmap<W, H> &bitmap, int x, int y, bool black) {
+  if (!clipContains(bitmap, x, y)) {
+    return;
+  }
+  writeMasked(bitmapColumn(bitmap, x)[columnByteIndex(y)], columnBitMask(y),
+              black);
+  markDirty(bitmap, x, x + 1);
+}
+
+template <int W, int H>
+void clearPixel(PrinterBitmap<W, H> &bitmap, int x, int y) {
+  setPixel(bitmap, x, y, false);
+}
+
+template <int W, int H>
+void fillBitmap(PrinterBitmap<W, H> &bitmap, bool black) {
+  if (!clipIsCanvas(bitmap)) {
+    const ClipRect &clip = bitmap.clip.rect;
+    for (int x = clip.x1; x < clip.x2; x++) {
+      fillColumnSpan(bitmap, x, clip.y1, clip.y2, black);
+    }
+    return;
+  }
+  fillBuffer(bitmap.data, PrinterBitmap<W, H>::SIZE, black ? 0xFF : 0x00);
+  markAllDirty(bitmap);
+}
+
+template <int W, int H> void clearBitmap(PrinterBitmap<W, H> &bitmap) {
+  if (!clipIsCanvas(bitmap)) {
+    fillBitmap(bitmap, false);
+    return;
+  }
+  clearBuffer(bitmap.data, PrinterBitmap<W, H>::SIZE);
+  markAllDirty(bitmap);
+}
+
+// A horizontal run touches the same byte of every column in the run
+template <int W, int H>
+void fillSpan(PrinterBitmap<W, H> &bitmap, int y, int x1, int x2, bool black) {
+  const ClipRect &clip = bitmap.clip.rect;
+  if (y < clip.y1 || y >= clip.y2) {
+    return;
+  }
+  if (x1 < clip.x1)
+    x1 = clip.x1;
+  if (x2 > clip.x2)
+    x2 = clip.x2;
+  if (x1 >= x2) {
+    return;
+  }
+
+  markDirty(bitmap, x1, x2);
+
+  const uint8_t mask = columnBitMask(y);
+  uint8_t *p = bitmapColumn(bitmap, x1) + columnByteIndex(y);
+  for (int x = x1; x < x2; x++) {
+    writeMasked(*p, mask, black);
+    p += PrinterBitmap<W, H>::BYTES_PER_COLUMN;
+  }
+}
+
+// Merge mask bits of the little-endian 16-bit word at p
+static inline void writeMaskedWord(uint8_t *p, uint16_t mask, bool black) {
+  writeMasked(p[0], mask & 0xFF, black);
+  writeMasked(p[1], mask >> 8, black);
+}
+
+template <int W, int H>
+void fillColumnSpan(PrinterBitmap<W, H> &bitmap, int x, int y1, int y2,
+                    bool black) {
+  const ClipRect &clip = bitmap.clip.rect;
+  if (x < clip.x1 || x >= clip.x2) {
+    return;
+  }
+  if (y1 < clip.y1)
+    y1 = clip.y1;
+  if (y2 > clip.y2)
+    y2 = clip.y2;
+  if (y1 >= y2) {
+    return;
+  }
+
+  markDirty(bitmap, x, x + 1);
+
+  uint8_t *column = bitmapColumn(bitmap, x);
+  const int firstWord = y1 >> 4;
+  const int lastWord = (y2 - 1) >> 4;
+  const uint16_t headMask = 0xFFFF >> (y1 & 15);
+  const uint16_t tailMask = 0xFFFF << (15 - ((y2 - 1) & 15));
+
+  if (firstWord == lastWord) {
+    writeMaskedWord(column + firstWord * 2, headMask & tailMask, black);
+    return;
+  }
+
+  writeMaskedWord(column + firstWord * 2, headMask, black);
+  if (lastWord - firstWord > 1) {
+    memset(column + (firstWord + 1) * 2, black ? 0xFF : 0x00,
+           (lastWord - firstWord - 1) * 2);
+  }
+  writeMaskedWord(column + lastWord * 2, tailMask, black);
+}
+
+// Columns are contiguous, so a rectangle is one column span per column
+template <int W, int H>
+void fillRect(PrinterBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2) {
+  if (x1 > x2) {
+    int temp = x1;
+    x1 = x2;
+    x2 = temp;
+  }
+  if (y1 > y2) {
+    int temp = y1;
+    y1 = y2;
+    y2 = temp;
+  }
+  if (x1 < bitmap.clip.rect.x1)
+    x1 = bitmap.clip.rect.x1;
+  if (x2 > bitmap.clip.rect.x2 - 1)
+    x2 = bitmap.clip.rect.x2 - 1;
+
+  for (int x = x1; x <= x2; x++) {
+    fillColumnSpan(bitmap, x, y1, y2 + 1, true);
+  }
+}
+
+// Bits [offset, offset + 8) of a packed MSB-first stream of `count` bits.
+// byteAt maps a logical byte index to storage; bits outside the stream read 0.
+template <typename ByteAt>
+static inline uint8_t extractBits8(ByteAt byteAt, int count, int offset) {
+  const int nbytes = (count + 7) >> 3;
+  const uint8_t lastMask = 0xFF << ((8 - (count & 7)) & 7);
+  const int q = offset >> 3; // arithmetic shift floors negative offsets
+  const int r = offset & 7;
+
+  uint16_t pair = 0;
+  for (int i = 0; i < 2; i++) {
+    const int idx = q + i;
+    uint8_t b = 0;
+    if (idx >= 0 && idx < nbytes) {
+      b = byteAt(idx);
+      if (idx == nbytes - 1)
+        b &= lastMask;
+    }
+    pair = (pair << 8) | b;
+  }
+  return (pair << r) >> 8;
+}
+
+// OR a packed bit stream starting at row y into one printer-format column,
+// one destination byte at a time (shift-and-merge, no per-pixel work). Only
+// rows [y1, y2) are written: the first and last bytes are masked.
+template <typename ByteAt>
+static void orColumnRows(uint8_t *column, int y, ByteAt byteAt, int count,
+                         int y1, int y2) {
+  if (y1 < y)
+    y1 = y;
+  if (y2 > y + count)
+    y2 = y + count;
+  if (y1 >= y2) {
+    return;
+  }
+
+  const int firstByte = y1 >> 3;
+  const int lastByte = (y2 - 1) >> 3;
+  for (int k = firstByte; k <= lastByte; k++) {
+    uint8_t mask = 0xFF;
+    if (k == firstByte)
+      mask &= 0xFF >> (y1 & 7);
+    if (k == lastByte)
+      mask &= 0xFF << (7 - ((y2 - 1) & 7));
+    column[k ^ 1] |= extractBits8(byteAt, count, k * 8 - y) & mask;
+  }
+}
+
+void orColumnBits(uint8_t *column, int y, const uint8_t *bits, int count,
+                  int y1, int y2) {
+  orColumnRows(
+      column, y, [bits](int i) { return bits[i]; }, count, y1, y2);
+}
+
+// Column x of a canvas, clipped to its clip rectangle
+template <int W, int H, typename ByteAt>
+static void orColumnStream(PrinterBitmap<W, H> &dest, int x, int y,
+                           ByteAt byteAt, int count) {
+  const ClipRect &clip = dest.clip.rect;
+  if (x < clip.x1 || x >= clip.x2 || count <= 0) {
+    return;
+  }
+  if (y >= clip.y2 || y + count <= clip.y1) {
+    return;
+  }
+
+  markDirty(dest, x, x + 1);
+  orColumnRows(bitmapColumn(dest, x), y, byteAt, count, clip.y1, clip.y2);
+}
+
+template <int W, int H>
+void blitColumnBits(PrinterBitmap<W, H> &dest, int x, int y,
+                    const uint8_t *bits, int count) {
+  orColumnStream(
+      dest, x, y, [bits](int i) { return bits[i]; }, count);
+}
+
+template <int W, int H>
+void blitColumns(PrinterBitmap<W, H> &dest, int destX, int destY,
+                 const PrinterBitmap<W, H> &src, int srcX, int width) {
+  for (int i = 0; i < width; i++) {
+    const int sx = srcX + i;
+    if (sx < 0 || sx >= W) {
+      continue;
+    }
+    // Source columns are word-swapped too, so undo the swap when reading
+    const uint8_t *column = bitmapColumn(src, sx);
+    orColumnStream(
+        dest, destX + i, destY, [column](int k) { return column[k ^ 1]; }, H);
+  }
+}
+
+// ============================================================================
+// MIRRORING
+// A mirrored MSB-first byte is a table lookup, so a row mirrors by swapping
+// its bytes end for end through the table. Rows and printer-format columns
+// are contiguous, which makes the other direction whole-block swaps.
+// ============================================================================
+
+// BIT_REVERSE[b] is b with its bit order reversed
+#define REVERSE_2(n) n, n + 2 * 64, n + 1 * 64, n + 3 * 64
+#define REVERSE_4(n)                                                           \
+  REVERSE_2(n), REVERSE_2(n + 2 * 16), REVERSE_2(n + 1 * 16),                  \
+      REVERSE_2(n + 3 * 16)
+#define REVERSE_6(n)                                                           \
+  REVERSE_4(n), REVERSE_4(n + 2 * 4), REVERSE_4(n + 1 * 4),                    \
+      REVERSE_4(n + 3 * 4)
+static constexpr uint8_t BIT_REVERSE[256] = {REVERSE_6(0), REVERSE_6(2),
+                                             REVERSE_6(1), REVERSE_6(3)};
+#undef REVERSE_2
+#undef REVERSE_4
+#undef REVERSE_6
+
+// Mirror `count` bytes end for end, each through BIT_REVERSE. index maps a
+// logical byte to its position (printer columns are word-swapped).
+template <typename Index>
+static inline void reverseBytes(uint8_t *bytes, int count, Index index) {
+  int i = 0;
+  for (int j = count - 1; i < j; i++, j--) {
+    const uint8_t first = BIT_REVERSE[bytes[index(i)]];
+    bytes[index(i)] = BIT_REVERSE[bytes[index(j)]];
+    bytes[index(j)] = first;
+  }
+  if (i == count - 1 - i) {
+    bytes[index(i)] = BIT_REVERSE[bytes[index(i)]];
+  }
+}
+
+// The mirrored row starts with the padding bits past W, shifted out here
+template <int W, int H> void flipH(BasicBitmap<W, H> &bitmap) {
+  const int rowBytes = (W + 7) >> 3;
+  const int pad = rowBytes * 8 - W;
+  for (int y = 0; y < H; y++) {
+    uint8_t *row = bitmapRow(bitmap, y);
+    reverseBytes(row, rowBytes, [](int i) { return i; });
+    if (pad) {
+      for (int i = 0; i < rowBytes - 1; i++) {
+        row[i] = (row[i] << pad) | (row[i + 1] >> (8 - pad));
+      }
+      row[rowBytes - 1] <<= pad;
+    }
+  }
+  markAllDirty(bitmap);
+}
+
+template <int W, int H> void flipV(BasicBitmap<W, H> &bitmap) {
+  const int stride = BasicBitmap<W, H>::STRIDE;
+  uint8_t saved[stride];
+  for (int y = 0; y < H / 2; y++) {
+    uint8_t *top = bitmapRow(bitmap, y);
+    uint8_t *bottom = bitmapRow(bitmap, H - 1 - y);
+    memcpy(saved, top, stride);
+    memcpy(top, bottom, stride);
+    memcpy(bottom, saved, stride);
+  }
+  markAllDirty(bitmap);
+}
+
+template <int W, int H> void flipH(PrinterBitmap<W, H> &bitmap) {
+  const int bytesPerColumn = PrinterBitmap<W, H>::BYTES_PER_COLUMN;
+  uint8_t saved[bytesPerColumn];
+  for (int x = 0; x < W / 2; x++) {
+    uint8_t *left = bitmapColumn(bitmap, x);
+    uint8_t *right = bitmapColumn(bitmap, W - 1 - x);
+    memcpy(saved, left, bytesPerColumn);
+    memcpy(left, right, bytesPerColumn);
+    memcpy(right, saved, bytesPerColumn);
+  }
+  markAllDirty(bitmap);
+}
+
+// A column is an MSB-first stream of H bits (H a multiple of 16) once the
+// word swap is undone, so it mirrors exactly like a row
+template <int W, int H> void flipV(PrinterBitmap<W, H> &bitmap) {
+  for (int x = 0; x < W; x++) {
+    reverseBytes(bitmapColumn(bitmap, x), PrinterBitmap<W, H>::BYTES_PER_COLUMN,
+                 [](int i) { return i ^ 1; });
+  }
+  markAllDirty(bitmap);
+}
+
+// ============================================================================
+// ROTATION
+// The turned image is built one destination-aligned 8x8 block at a time: the
+// eight source bytes that land in the block are gathered (at any bit offset)
+// and, for a quarter turn, transposed. Only pixels inside both the turned
+// image and the clip are written.
+// ============================================================================
+
+// Pixels [x, x + 8) of source row y, MSB first; white outside the rows
+static uint8_t viewByte(const BitmapView &src, int y, int x) {
+  if (y < 0 || y >= src.height) {
+    return 0;
+  }
+  const uint8_t *row = src.data + y * src.stride;
+  const int rowBytes = (src.width + 7) >> 3;
+  const int q = x >> 3;
+  const int shift = x & 7;
+  const uint8_t hi = (q >= 0 && q < rowBytes) ? row[q] : 0;
+  if (!shift) {
+    return hi;
+  }
+  const uint8_t lo = (q + 1 >= 0 && q + 1 < rowBytes) ? row[q + 1] : 0;
+  return (hi << shift) | (lo >> (8 - shift));
+}
+
+// Rows of the 8x8 block at (u, v) of src turned clockwise `Turns` quarters
+template <int Turns>
+static void turnedBlock(const BitmapView &src, int u, int v,
+                        uint8_t block[8]) {
+  uint8_t gathered[8];
+  if (Turns == 2) {
+    // Rows and columns both run backwards
+    for (int r = 0; r < 8; r++) {
+      block[r] = BIT_REVERSE[viewByte(src, src.height - 1 - (v + r),
+                                      src.width - 1 - (u + 7))];
+    }
+  } else if (Turns == 1) {
+    // Block column c is source row height - 1 - (u + c), read from column v
+    for (int c = 0; c < 8; c++) {
+      gathered[c] = viewByte(src, src.height - 1 - (u + c), v);
+    }
+    transposeBits8x8(gathered, 1, block, 1);
+  } else {
+    // Block column c is source row u + c, read bottom row first
+    for (int c = 0; c < 8; c++) {
+      gathered[c] = viewByte(src, u + c, src.width - 1 - (v + 7));
+    }
+    uint8_t transposed[8];
+    transposeBits8x8(gathered, 1, transposed, 1);
+    for (int r = 0; r < 8; r++) {
+      block[r] = transposed[7 - r];
+    }
+  }
+}
+
+// Write the block at (bx, by) (multiples of 8), limited to [x1, x2) x [y1, y2)
+template <int W, int H>
+static void writeBlock(BasicBitmap<W, H> &dest, int bx, int by,
+                       const uint8_t block[8], int x1, int y1, int x2,
+                       int y2) {
+  uint8_t mask = 0xFF;
+  if (x1 > bx)
+    mask &= 0xFF >> (x1 - bx);
+  if (x2 < bx + 8)
+    mask &= 0xFF << (bx + 8 - x2);
+  for (int r = 0; r < 8; r++) {
+    const int y = by + r;
+    if (y >= y1 && y < y2) {
+      uint8_t &byte = bitmapRow(dest, y)[bx >> 3];
+      byte = (byte & ~mask) | (block[r] & mask);
+    }
+  }
+}
+
+// A block is one byte of each of its eight columns: transpose it back
+template <int W, int H>
+static void writeBlock(PrinterBitmap<W, H> &dest, int bx, int by,
+                       const uint8_t block[8], int x1, int y1, int x2,
+                       int y2) {
+  uint8_t mask = 0xFF;
+  if (y1 > by)
+    mask &= 0xFF >> (y1 - by);
+  if (y2 < by + 8)
+    mask &= 0xFF << (by + 8 - y2);
+  uint8_t columns[8];
+  transposeBits8x8(block, 1, columns, 1);
+  const int byteIdx = columnByteIndex(by);
+  for (int c = 0; c < 8; c++) {
+    const int x = bx + c;
+    if (x >= x1 && x < x2) {
+      uint8_t &byte = bitmapColumn(dest, x)[byteIdx];
+      byte = (byte & ~mask) | (columns[c] & mask);
+    }
+  }
+}
+
+template <int Turns, typename BitmapT>
+static void rotateInto(BitmapT &dest, int destX, int destY,
+                       const BitmapView &src) {
+  const int width = Turns == 2 ? src.width : src.height;
+  const int height = Turns == 2 ? src.height : src.width;
+  const ClipRect &clip = dest.clip.rect;
+  const int x1 = destX > clip.x1 ? destX : clip.x1;
+  const int y1 = destY > clip.y1 ? destY : clip.y1;
+  const int x2 = destX + width < clip.x2 ? destX + width : clip.x2;
+  const int y2 = destY + height < clip.y2 ? destY + height : clip.y2;
+  if (x1 >= x2 || y1 >= y2) {
+    return;
+  }
+
+  markDirty(dest, x1, x2);
+
+  uint8_t block[8];
+  for (int by = y1 & ~7; by < y2; by += 8) {
+    for (int bx = x1 & ~7; bx < x2; bx += 8) {
+      turnedBlock<Turns>(src, bx - destX, by - destY, block);
+      writeBlock(dest, bx, by, block, x1, y1, x2, y2);
+    }
+  }
+}
+
+template <int W, int H>
+void rotate90(BasicBitmap<W, H> &dest, int destX, int destY,
+              const BitmapView &src) {
+  rotateInto<1>(dest, destX, destY, src);
+}
+
+template <int W, int H>
+void rotate180(BasicBitmap<W, H> &dest, int destX, int destY,
+               const BitmapView &src) {
+  rotateInto<2>(dest, destX, destY, src);
+}
+
+template <int W, int H>
+void rotate270(BasicBitmap<W, H> &dest, int destX, int destY,
+               const BitmapView &src) {
+  rotateInto<3>(dest, destX, destY, src);
+}
+
+template <int W, int H>
+void rotate90(PrinterBitmap<W, H> &dest, int destX, int destY,
+              const BitmapView &src) {
+  rotateInto<1>(dest, destX, destY, src);
+}
+
+template <int W, int H>
+void rotate180(PrinterBitmap<W, H> &dest, int destX, int destY,
+               const BitmapView &src) {
+  rotateInto<2>(dest, destX, destY, src);
+}
+
+template <int W, int H>
+void rotate270(PrinterBitmap<W, H> &dest, int destX, int destY,
+               const BitmapView &src) {
+  rotateInto<3>(dest, destX, destY, src);
+}
+
+// ============================================================================
+// EXPLICIT INSTANTIATIONS (one per tape canvas)
+// ============================================================================
+
+#define INSTANTIATE_BITMAP_OPERATIONS(W, H)                                    \
+  template BasicBitmap<W, H> *createEmptyBitmapPtr<W, H>();                    \
+  template BasicBitmap<W, H> createEmptyBitmap<W, H>();                        \
+  template BasicBitmap<W, H> createFilledBitmap<W, H>(bool);                   \
+  template void setPixel(BasicBitmap<W, H> &, int, int, bool);                 \
+  template void clearPixel(BasicBitmap<W, H> &, int, int);                     \
+  template void fillBitmap(BasicBitmap<W, H> &, bool);                         \
+  template void clearBitmap(BasicBitmap<W, H> &);                              \
+  template void fillSpan(BasicBitmap<W, H> &, int, int, int, bool);            \
+  template void mapPixels(BasicBitmap<W, H> &, int, int, int, int,             \
+                          std::function<bool(int, int)>);                      \
+  template void drawBorder(BasicBitmap<W, H> &, int);                          \
+  template void drawDiagonals(BasicBitmap<W, H> &);                            \
+  template void drawChar(BasicBitmap<W, H> &, char, int, int);                 \
+  template void drawString(BasicBitmap<W, H> &, const char *, int, int);       \
+  template void drawRect(BasicBitmap<W, H> &, int, int, int, int);             \
+  template void fillRect(BasicBitmap<W, H> &, int, int, int, int);             \
+  template void drawLine(BasicBitmap<W, H> &, int, int, int, int);             \
+  template void drawCircle(BasicBitmap<W, H> &, int, int, int);                \
+  template void fillCircle(BasicBitmap<W, H> &, int, int, int);                \
+  template void fillEllipse(BasicBitmap<W, H> &, int, int, int, int);          \
+  template void fillRing(BasicBitmap<W, H> &, int, int, int, int);             \
+  template void fillRoundRect(BasicBitmap<W, H> &, int, int, int, int, int);   \
+  template void invertBitmap(BasicBitmap<W, H> &);                             \
+  template void flipH(BasicBitmap<W, H> &);                                    \
+  template void flipV(BasicBitmap<W, H> &);                                    \
+  template void copyBitmap(BasicBitmap<W, H> &, const BasicBitmap<W, H> &);    \
+  template void drawGrid(BasicBitmap<W, H> &, int);                            \
+  template void drawCheckerboard(BasicBitmap<W, H> &, int);                    \
+  template void blit(BasicBitmap<W, H> &, int, int, const BitmapView &, int,   \
+                     int, int, int, RasterOp);                                 \
+  template void rotate90(BasicBitmap<W, H> &, int, int, const BitmapView &);   \
+  template void rotate180(BasicBitmap<W, H> &, int, int, const BitmapView &);  \
+  template void rotate270(BasicBitmap<W, H> &, int, int, const BitmapView &);  \
+  template void compose(BasicBitmap<W, H> &,                                   \
+                        BasicBitmap<W, H>::Operation,                          \
+                        BasicBitmap<W, H>::Operation,                          \
+                        BasicBitmap<W, H>::Operation);
+
+#define INSTANTIATE_PRINTER_BITMAP_OPERATIONS(W, H)                            \
+  template PrinterBitmap<W, H> *createEmptyPrinterBitmapPtr<W, H>();           \
+  template void setPixel(PrinterBitmap<W, H> &, int, int, bool);               \
+  template void clearPixel(PrinterBitmap<W, H> &, int, int);                   \
+  template void fillBitmap(PrinterBitmap<W, H> &, bool);                       \
+  template void clearBitmap(PrinterBitmap<W, H> &);                            \
+  template void fillSpan(PrinterBitmap<W, H> &, int, int, int, bool);          \
+  template void fillColumnSpan(PrinterBitmap<W, H> &, int, int, int, bool);    \
+  template void fillRect(PrinterBitmap<W, H> &, int, int, int, int);           \
+  template void blitColumnBits(PrinterBitmap<W, H> &, int, int,                \
+                               const uint8_t *, int);                          \
+  template void blitColumns(PrinterBitmap<W, H> &, int, int,                   \
+                            const PrinterBitmap<W, H> &, int, int);        \
+  template void flipH(PrinterBitmap<W, H> &);                                  \
+  template void flipV(PrinterBitmap<W, H> &);                                  \
+  template void rotate90(PrinterBitmap<W, H> &, int, int,                      \
+                         const BitmapView &);                                  \
+  template void rotate180(PrinterBitmap<W, H> &, int, int,                     \
+                          const BitmapView &);                                 \
+  template void rotate270(PrinterBitmap<W, H> &, int, int,                     \
+                          const BitmapView &);
+
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_BITMAP_OPERATIONS)
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_PRINTER_BITMAP_OPERATIONS)
+
+#undef INSTANTIATE_BITMAP_OPERATIONS
+#undef INSTANTIATE_PRINTER_BITMAP_OPERATIONS
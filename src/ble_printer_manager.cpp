@@ -36,7 +36,9 @@ uint8_t calculateFrameChecksum(const uint8_t *data, size_t len) {
 // PRINT JOB MANAGEMENT
 // ============================================================================
 
-bool prepareFramesFromBitmap(const Bitmap &userBitmap) {
+// Works for row-major and printer-format canvases and text-only labels
+template <typename BitmapT>
+bool prepareFramesFromBitmap(const BitmapT &userBitmap) {
 
   printFrames = compressAndGenerateFrames(userBitmap, mtu);
 
@@ -140,13 +142,37 @@ bool startPrintJob() {
 }
 
 // High-level: Prepare and print in one call
-bool printBitmap(const Bitmap &userBitmap) {
+template <int W, int H> bool printBitmap(const BasicBitmap<W, H> &userBitmap) {
   if (!prepareFramesFromBitmap(userBitmap)) {
     return false;
   }
   return startPrintJob();
 }
 
+template <int W, int H>
+bool printBitmap(const PrinterBitmap<W, H> &userBitmap) {
+  if (!prepareFramesFromBitmap(userBitmap)) {
+    return false;
+  }
+  return startPrintJob();
+}
+
+template <int W, int H> bool printBitmap(const TextLabel<W, H> &label) {
+  if (!prepareFramesFromBitmap(label)) {
+    return false;
+  }
+  return startPrintJob();
+}
+
+#define INSTANTIATE_PRINT_BITMAP(W, H)                                         \
+  template bool printBitmap(const BasicBitmap<W, H> &);                        \
+  template bool printBitmap(const PrinterBitmap<W, H> &);                      \
+  template bool printBitmap(const TextLabel<W, H> &);
+
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_PRINT_BITMAP)
+
+#undef INSTANTIATE_PRINT_BITMAP
+
 // ============================================================================
 // BLE SCANNER & CONNECTION
 // ============================================================================
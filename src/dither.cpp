@@ -0,0 +1,354 @@
+#include <dither.h>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ============================================================================
+// ERROR DIFFUSION
+// Errors are in 1/16 gray levels. Shares are rounded down and whatever the
+// rounding leaves goes to the last neighbour, so no error is lost (Atkinson
+// drops its quarter on purpose).
+// ============================================================================
+
+bool startDither(Ditherer &ditherer, DitherMethod method, int x, int y,
+                 int width) {
+  if (width < 1 || width > MAX_DITHER_WIDTH) {
+    return false;
+  }
+  ditherer.method = method;
+  ditherer.x = x;
+  ditherer.y = y;
+  ditherer.width = width;
+  ditherer.current = 0;
+  switch (method) {
+  case DITHER_FLOYD_STEINBERG:
+  case DITHER_SIERRA_LITE:
+    ditherer.errorRows = 2;
+    break;
+  case DITHER_ATKINSON:
+    ditherer.errorRows = 3;
+    break;
+  default:
+    ditherer.errorRows = 0;
+    return true;
+  }
+  memset(ditherer.error, 0, sizeof(ditherer.error));
+  return true;
+}
+
+// Quantize one row into ditherer.bits and push its error down
+template <DitherMethod M>
+static void diffuseRow(Ditherer &ditherer, const uint8_t *gray) {
+  const int rows = ditherer.errorRows;
+  int16_t *row = ditherer.error[ditherer.current] + 1;
+  int16_t *below = ditherer.error[(ditherer.current + 1) % rows] + 1;
+  int16_t *twoBelow = ditherer.error[(ditherer.current + 2) % rows] + 1;
+  uint8_t *bits = ditherer.bits;
+  const int shift = ditherer.x & 7;
+
+  clearBuffer(bits, sizeof(ditherer.bits));
+  for (int i = 0; i < ditherer.width; i++) {
+    const int value = gray[i] * 16 + row[i];
+    int error = value;
+    if (value < 128 * 16) {
+      const int bit = shift + i;
+      bits[bit >> 3] |= 0x80 >> (bit & 7);
+    } else {
+      error -= 255 * 16;
+    }
+
+    if (M == DITHER_FLOYD_STEINBERG) {
+      const int right = (error * 7) >> 4;
+      const int belowLeft = (error * 3) >> 4;
+      const int straightBelow = (error * 5) >> 4;
+      row[i + 1] += right;
+      below[i - 1] += belowLeft;
+      below[i] += straightBelow;
+      below[i + 1] += error - right - belowLeft - straightBelow;
+    } else if (M == DITHER_ATKINSON) {
+      const int share = error >> 3;
+      row[i + 1] += share;
+      row[i + 2] += share;
+      below[i - 1] += share;
+      below[i] += share;
+      below[i + 1] += share;
+      twoBelow[i] += share;
+    } else {
+      const int share = error >> 2;
+      below[i - 1] += share;
+      below[i] += share;
+      row[i + 1] += error - 2 * share;
+    }
+  }
+
+  // This row's error is spent; its buffer becomes the farthest row down
+  memset(ditherer.error[ditherer.current], 0, sizeof(ditherer.error[0]));
+  ditherer.current = (ditherer.current + 1) % rows;
+}
+
+// ============================================================================
+// ORDERED DITHERING
+// A pixel is dark when it is below the threshold for its canvas position.
+// Threshold rows are stored 8 wide (the 4x4 matrix twice), so every output
+// byte compares 8 pixels with the same row; host builds do 16 or 32 pixels
+// per compare and take the bits out with movemask.
+// ============================================================================
+
+// Bayer index matrices scaled to gray levels: index * 256 / cells + half
+static const uint8_t BAYER_4X4_ROWS[4][8] = {
+    {8, 136, 40, 168, 8, 136, 40, 168},
+    {200, 72, 232, 104, 200, 72, 232, 104},
+    {56, 184, 24, 152, 56, 184, 24, 152},
+    {248, 120, 216, 88, 248, 120, 216, 88},
+};
+
+static const uint8_t BAYER_8X8_ROWS[8][8] = {
+    {2, 130, 34, 162, 10, 138, 42, 170},
+    {194, 66, 226, 98, 202, 74, 234, 106},
+    {50, 178, 18, 146, 58, 186, 26, 154},
+    {242, 114, 210, 82, 250, 122, 218, 90},
+    {14, 142, 46, 174, 6, 134, 38, 166},
+    {206, 78, 238, 110, 198, 70, 230, 102},
+    {62, 190, 30, 158, 54, 182, 22, 150},
+    {254, 126, 222, 94, 246, 118, 214, 86},
+};
+
+static const uint8_t THRESHOLD_ROW[8] = {128, 128, 128, 128,
+                                         128, 128, 128, 128};
+
+static const uint8_t *thresholdRow(DitherMethod method, int y) {
+  switch (method) {
+  case DITHER_BAYER_4X4:
+    return BAYER_4X4_ROWS[y & 3];
+  case DITHER_BAYER_8X8:
+    return BAYER_8X8_ROWS[y & 7];
+  default:
+    return THRESHOLD_ROW;
+  }
+}
+
+// 8 pixels against a threshold row, the first pixel in the top bit
+static inline uint8_t orderedByte(const uint8_t *gray,
+                                  const uint8_t *thresholds) {
+  uint8_t bits = 0;
+  for (int k = 0; k < 8; k++) {
+    bits |= (gray[k] < thresholds[k]) << (7 - k);
+  }
+  return bits;
+}
+
+// Same for a byte that hangs over either end of the image, whose pixels
+// start at image column `first`
+static uint8_t orderedEdgeByte(const uint8_t *gray, const uint8_t *thresholds,
+                               int first, int width) {
+  uint8_t bits = 0;
+  for (int k = 0; k < 8; k++) {
+    const int i = first + k;
+    if (i >= 0 && i < width && gray[i] < thresholds[k]) {
+      bits |= 0x80 >> k;
+    }
+  }
+  return bits;
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+// movemask puts the first pixel in bit 0; the canvas wants it in bit 7
+static inline uint8_t reverseBits(uint32_t bits) {
+  bits = ((bits & 0xF0) >> 4) | ((bits & 0x0F) << 4);
+  bits = ((bits & 0xCC) >> 2) | ((bits & 0x33) << 2);
+  bits = ((bits & 0xAA) >> 1) | ((bits & 0x55) << 1);
+  return bits;
+}
+#endif
+
+static void orderedRow(Ditherer &ditherer, const uint8_t *gray) {
+  const uint8_t *thresholds = thresholdRow(ditherer.method, ditherer.y);
+  const int width = ditherer.width;
+  const int shift = ditherer.x & 7;
+  const int byteCount = (shift + width + 7) >> 3;
+  uint8_t *bits = ditherer.bits;
+
+  // Byte k holds image columns [8k - shift, 8k - shift + 8)
+  int k = 0;
+  if (shift) {
+    bits[k++] = orderedEdgeByte(gray, thresholds, -shift, width);
+  }
+  int i = 8 * k - shift;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+  // Unsigned compare as signed with the top bits flipped
+  int64_t row;
+  memcpy(&row, thresholds, sizeof(row));
+#endif
+#if defined(__AVX2__)
+  const __m256i flip = _mm256_set1_epi8((char)0x80);
+  const __m256i limits = _mm256_xor_si256(_mm256_set1_epi64x(row), flip);
+  for (; i + 32 <= width; i += 32, k += 4) {
+    const __m256i pixels = _mm256_xor_si256(
+        _mm256_loadu_si256((const __m256i *)(gray + i)), flip);
+    const uint32_t dark =
+        _mm256_movemask_epi8(_mm256_cmpgt_epi8(limits, pixels));
+    bits[k] = reverseBits(dark & 0xFF);
+    bits[k + 1] = reverseBits((dark >> 8) & 0xFF);
+    bits[k + 2] = reverseBits((dark >> 16) & 0xFF);
+    bits[k + 3] = reverseBits(dark >> 24);
+  }
+#elif defined(__SSE2__)
+  const __m128i flip = _mm_set1_epi8((char)0x80);
+  const __m128i limits = _mm_xor_si128(_mm_set1_epi64x(row), flip);
+  for (; i + 16 <= width; i += 16, k += 2) {
+    const __m128i pixels =
+        _mm_xor_si128(_mm_loadu_si128((const __m128i *)(gray + i)), flip);
+    const uint32_t dark = _mm_movemask_epi8(_mm_cmpgt_epi8(limits, pixels));
+    bits[k] = reverseBits(dark & 0xFF);
+    bits[k + 1] = reverseBits(dark >> 8);
+  }
+#endif
+
+  for (; i + 8 <= width; i += 8, k++) {
+    bits[k] = orderedByte(gray + i, thresholds);
+  }
+  if (k < byteCount) {
+    bits[k] = orderedEdgeByte(gray, thresholds, i, width);
+  }
+}
+
+// Fill ditherer.bits from one source row
+static void ditherBits(Ditherer &ditherer, const uint8_t *gray) {
+  switch (ditherer.method) {
+  case DITHER_FLOYD_STEINBERG:
+    diffuseRow<DITHER_FLOYD_STEINBERG>(ditherer, gray);
+    break;
+  case DITHER_ATKINSON:
+    diffuseRow<DITHER_ATKINSON>(ditherer, gray);
+    break;
+  case DITHER_SIERRA_LITE:
+    diffuseRow<DITHER_SIERRA_LITE>(ditherer, gray);
+    break;
+  case DITHER_BAYER_4X4:
+  case DITHER_BAYER_8X8:
+  case DITHER_THRESHOLD:
+    orderedRow(ditherer, gray);
+    break;
+  }
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+// Canvas columns [x1, x2) of the row just diffused, clipped; false if none
+template <typename BitmapT>
+static bool clippedRow(const BitmapT &bitmap, const Ditherer &ditherer,
+                       int y, int &x1, int &x2) {
+  const ClipRect &clip = bitmap.clip.rect;
+  if (y < clip.y1 || y >= clip.y2) {
+    return false;
+  }
+  x1 = ditherer.x > clip.x1 ? ditherer.x : clip.x1;
+  x2 = ditherer.x + ditherer.width;
+  if (x2 > clip.x2)
+    x2 = clip.x2;
+  return x1 < x2;
+}
+
+// ditherer.bits already lines up with the canvas bytes, so a row is written
+// a byte at a time with masks only at the ends
+template <int W, int H>
+void ditherRow(BasicBitmap<W, H> &bitmap, Ditherer &ditherer,
+               const uint8_t *gray) {
+  ditherBits(ditherer, gray);
+  const int y = ditherer.y++;
+  int x1, x2;
+  if (!clippedRow(bitmap, ditherer, y, x1, x2)) {
+    return;
+  }
+  markDirty(bitmap, x1, x2);
+
+  uint8_t *row = bitmapRow(bitmap, y);
+  const int base = ditherer.x >> 3; // canvas byte of ditherer.bits[0]
+  const int firstByte = x1 >> 3;
+  const int lastByte = (x2 - 1) >> 3;
+  for (int b = firstByte; b <= lastByte; b++) {
+    uint8_t mask = 0xFF;
+    if (b == firstByte)
+      mask &= 0xFF >> (x1 & 7);
+    if (b == lastByte)
+      mask &= 0xFF << (7 - ((x2 - 1) & 7));
+    row[b] = (row[b] & ~mask) | (ditherer.bits[b - base] & mask);
+  }
+}
+
+// A row is one bit of every column it crosses
+template <int W, int H>
+void ditherRow(PrinterBitmap<W, H> &bitmap, Ditherer &ditherer,
+               const uint8_t *gray) {
+  ditherBits(ditherer, gray);
+  const int y = ditherer.y++;
+  int x1, x2;
+  if (!clippedRow(bitmap, ditherer, y, x1, x2)) {
+    return;
+  }
+  markDirty(bitmap, x1, x2);
+
+  const uint8_t mask = columnBitMask(y);
+  const int first = x1 - (ditherer.x & ~7);
+  uint8_t *p = bitmapColumn(bitmap, x1) + columnByteIndex(y);
+  for (int bit = first; bit < first + x2 - x1; bit++) {
+    if (ditherer.bits[bit >> 3] & (0x80 >> (bit & 7))) {
+      *p |= mask;
+    } else {
+      *p &= ~mask;
+    }
+    p += PrinterBitmap<W, H>::BYTES_PER_COLUMN;
+  }
+}
+
+// Shared rather than stack: a Ditherer is over 1.5KB
+static Ditherer imageDitherer;
+
+template <typename BitmapT>
+static bool ditherRows(BitmapT &bitmap, const uint8_t *gray, int width,
+                       int height, int stride, int x, int y,
+                       DitherMethod method) {
+  if (!startDither(imageDitherer, method, x, y, width)) {
+    return false;
+  }
+  for (int row = 0; row < height; row++) {
+    ditherRow(bitmap, imageDitherer, gray + row * stride);
+  }
+  return true;
+}
+
+template <int W, int H>
+bool ditherImage(BasicBitmap<W, H> &bitmap, const uint8_t *gray, int width,
+                 int height, int stride, int x, int y, DitherMethod method) {
+  return ditherRows(bitmap, gray, width, height, stride, x, y, method);
+}
+
+template <int W, int H>
+bool ditherImage(PrinterBitmap<W, H> &bitmap, const uint8_t *gray, int width,
+                 int height, int stride, int x, int y, DitherMethod method) {
+  return ditherRows(bitmap, gray, width, height, stride, x, y, method);
+}
+
+// ============================================================================
+// EXPLICIT INSTANTIATIONS (one per tape canvas)
+// ============================================================================
+
+#define INSTANTIATE_DITHER(W, H)                                               \
+  template void ditherRow(BasicBitmap<W, H> &, Ditherer &, const uint8_t *);   \
+  template void ditherRow(PrinterBitmap<W, H> &, Ditherer &,                   \
+                          const uint8_t *);                                    \
+  template bool ditherImage(BasicBitmap<W, H> &, const uint8_t *, int, int,    \
+                            int, int, int, DitherMethod);                      \
+  template bool ditherImage(PrinterBitmap<W, H> &, const uint8_t *, int, int,  \
+                            int, int, int, DitherMethod);
+
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_DITHER)
+
+#undef INSTANTIATE_DITHER
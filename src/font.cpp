@@ -0,0 +1,519 @@
+#include <Arduino.h>
+#include <cstring>
+#include <font.h>
+
+// Compiled glyph tables. Each header defines its Font, so it is included here
+// and nowhere else.
+#include <fonts/font_5x7.h>
+
+// ============================================================================
+// GLYPH LOOKUP
+// ============================================================================
+
+const Glyph &findGlyph(const Font &font, uint32_t codepoint) {
+  // A handful of ranges per font, sorted by code point
+  for (int i = 0; i < font.rangeCount; i++) {
+    const FontRange &range = font.ranges[i];
+    if (codepoint < range.first) {
+      break;
+    }
+    if (codepoint - range.first < range.count) {
+      return font.glyphs[range.glyph + (codepoint - range.first)];
+    }
+  }
+  return font.glyphs[font.fallback];
+}
+
+// ============================================================================
+// GLYPH ROTATION
+// ============================================================================
+
+// Turn a glyph's rows into its columns (see glyphColumns)
+static void rotateGlyph(const uint8_t *rows, int width, int height,
+                        uint8_t *columns) {
+  const int rowBytes = (width + 7) >> 3;
+  const int columnBytes = (height + 7) >> 3;
+  clearBuffer(columns, width * columnBytes);
+  for (int r = 0; r < height; r++) {
+    const uint8_t *row = rows + r * rowBytes;
+    const uint8_t mask = 0x80 >> (r & 7);
+    for (int c = 0; c < width; c++) {
+      if (row[c >> 3] & (0x80 >> (c & 7))) {
+        columns[c * columnBytes + (r >> 3)] |= mask;
+      }
+    }
+  }
+}
+
+// ============================================================================
+// PACKED FONTS
+// Blocks are LZSS: a flag byte announces the next eight items, least
+// significant bit first. A clear bit is one literal byte; a set bit is a
+// two-byte match b0 b1 that copies (b1 & 0x0F) + 3 bytes from
+// ((b1 & 0xF0) << 4 | b0) + 1 bytes back in the output.
+// ============================================================================
+
+#define BLOCK_BUFFER_BYTES (FONT_BLOCK_GLYPHS * MAX_PACKED_GLYPH_BYTES)
+
+// Returns the unpacked size, or -1 for a corrupt block
+static int unpackBlock(const uint8_t *in, const uint8_t *inEnd, uint8_t *out,
+                       int capacity) {
+  int n = 0;
+  while (in < inEnd) {
+    uint8_t flags = *in++;
+    for (int bit = 0; bit < 8 && in < inEnd; bit++, flags >>= 1) {
+      if (!(flags & 1)) {
+        if (n >= capacity) {
+          return -1;
+        }
+        out[n++] = *in++;
+        continue;
+      }
+      if (inEnd - in < 2) {
+        return -1;
+      }
+      const int distance = (((in[1] & 0xF0) << 4) | in[0]) + 1;
+      const int length = (in[1] & 0x0F) + 3;
+      in += 2;
+      if (distance > n || n + length > capacity) {
+        return -1;
+      }
+      for (int i = 0; i < length; i++, n++) {
+        out[n] = out[n - distance];
+      }
+    }
+  }
+  return n;
+}
+
+struct GlyphSlot {
+  const Font *font; // nullptr while the slot is unused
+  uint16_t glyph;   // index into font->glyphs
+  uint32_t lastUse;
+  uint8_t rows[MAX_PACKED_GLYPH_BYTES];
+  uint8_t columns[MAX_PACKED_GLYPH_BYTES];
+};
+
+static GlyphSlot *g_glyphSlots = nullptr;
+static uint8_t *g_blockBuffer = nullptr; // last block unpacked
+static const Font *g_blockFont = nullptr;
+static int g_blockIndex = -1;
+static int g_blockSize = 0;
+static uint32_t g_glyphClock = 0;
+static GlyphCacheStats g_glyphStats = {0, 0};
+
+static bool initGlyphCache() {
+  g_glyphSlots = new (std::nothrow) GlyphSlot[GLYPH_CACHE_SLOTS]();
+  g_blockBuffer = new (std::nothrow) uint8_t[BLOCK_BUFFER_BYTES];
+  if (!g_glyphSlots || !g_blockBuffer) {
+    delete[] g_glyphSlots;
+    delete[] g_blockBuffer;
+    g_glyphSlots = nullptr;
+    g_blockBuffer = nullptr;
+    return false;
+  }
+  return true;
+}
+
+// Cache slot holding a packed glyph, unpacked into the least recently used
+// slot on a miss
+static const GlyphSlot *cachedGlyph(const Font &font, const Glyph &glyph) {
+  if (!g_glyphSlots && !initGlyphCache()) {
+    Serial.println("ERROR: Cannot allocate glyph cache");
+    return nullptr;
+  }
+
+  const int index = &glyph - font.glyphs;
+  GlyphSlot *victim = &g_glyphSlots[0];
+  for (int i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+    GlyphSlot &slot = g_glyphSlots[i];
+    if (slot.font == &font && slot.glyph == index) {
+      g_glyphStats.hits++;
+      slot.lastUse = ++g_glyphClock;
+      return &slot;
+    }
+    if (slot.lastUse < victim->lastUse) {
+      victim = &slot;
+    }
+  }
+  g_glyphStats.misses++;
+
+  const int block = index / FONT_BLOCK_GLYPHS;
+  if (g_blockFont != &font || g_blockIndex != block) {
+    g_blockFont = nullptr;
+    g_blockSize = unpackBlock(font.packed + font.blocks[block],
+                              font.packed + font.blocks[block + 1],
+                              g_blockBuffer, BLOCK_BUFFER_BYTES);
+    if (g_blockSize < 0) {
+      Serial.println("ERROR: Corrupt packed font block");
+      return nullptr;
+    }
+    g_blockFont = &font;
+    g_blockIndex = block;
+  }
+
+  const int size = ((glyph.width + 7) >> 3) * glyph.height;
+  if (size > MAX_PACKED_GLYPH_BYTES || glyph.offset + size > g_blockSize ||
+      glyph.width * ((glyph.height + 7) >> 3) > MAX_PACKED_GLYPH_BYTES) {
+    Serial.println("ERROR: Packed glyph out of range");
+    return nullptr;
+  }
+  memcpy(victim->rows, g_blockBuffer + glyph.offset, size);
+  rotateGlyph(victim->rows, glyph.width, glyph.height, victim->columns);
+  victim->font = &font;
+  victim->glyph = index;
+  victim->lastUse = ++g_glyphClock;
+  return victim;
+}
+
+const uint8_t *glyphRows(const Font &font, const Glyph &glyph) {
+  if (font.bitmaps) {
+    return font.bitmaps + glyph.offset;
+  }
+  const GlyphSlot *slot = cachedGlyph(font, glyph);
+  return slot ? slot->rows : nullptr;
+}
+
+GlyphCacheStats glyphCacheStats() { return g_glyphStats; }
+
+void resetGlyphCacheStats() {
+  g_glyphStats.hits = 0;
+  g_glyphStats.misses = 0;
+}
+
+// ============================================================================
+// RENDERING
+// ============================================================================
+
+template <int W, int H>
+int drawGlyph(BasicBitmap<W, H> &bitmap, const Font &font, uint32_t codepoint,
+              int x, int y) {
+  const Glyph &glyph = findGlyph(font, codepoint);
+  if (glyph.width > 0) {
+    const BitmapView image = glyphView(font, glyph);
+    if (image.data) {
+      blit(bitmap, x + glyph.left, y + glyph.top, image, 0, 0, glyph.width,
+           glyph.height, ROP_OR);
+    }
+  }
+  return glyph.advance;
+}
+
+template <int W, int H>
+int drawText(BasicBitmap<W, H> &bitmap, const Font &font, const char *str,
+             int x, int y) {
+  // Nothing on this line can become visible past the right clip edge
+  const int clipRight = bitmap.clip.rect.x2;
+  while (*str && x < clipRight) {
+    x += drawGlyph(bitmap, font, nextCodepoint(str), x, y);
+  }
+  while (*str) {
+    x += findGlyph(font, nextCodepoint(str)).advance;
+  }
+  return x;
+}
+
+int textAdvance(const Font &font, const char *str) {
+  int advance = 0;
+  while (*str) {
+    advance += findGlyph(font, nextCodepoint(str)).advance;
+  }
+  return advance;
+}
+
+// ============================================================================
+// COLUMN GLYPH CACHE
+// ============================================================================
+
+struct ColumnGlyphCache {
+  const Font *font;
+  uint8_t *columns;  // every glyph's columns, glyph by glyph
+  uint16_t *offsets; // first byte of each glyph's columns
+};
+
+static ColumnGlyphCache g_columnCache[MAX_COLUMN_FONTS];
+
+static int glyphCount(const Font &font) {
+  int count = 0;
+  for (int i = 0; i < font.rangeCount; i++) {
+    const int end = font.ranges[i].glyph + font.ranges[i].count;
+    if (end > count)
+      count = end;
+  }
+  return count;
+}
+
+// Rotate every glyph of the font from its row image into column order
+static bool buildColumnCache(const Font &font, ColumnGlyphCache &cache) {
+  const int count = glyphCount(font);
+  size_t total = 0;
+  for (int i = 0; i < count; i++) {
+    const Glyph &glyph = font.glyphs[i];
+    total += glyph.width * ((glyph.height + 7) >> 3);
+  }
+  if (total > 0xFFFF) {
+    return false;
+  }
+
+  uint8_t *columns = new (std::nothrow) uint8_t[total ? total : 1];
+  uint16_t *offsets = new (std::nothrow) uint16_t[count];
+  if (!columns || !offsets) {
+    delete[] columns;
+    delete[] offsets;
+    return false;
+  }
+  size_t offset = 0;
+  for (int i = 0; i < count; i++) {
+    const Glyph &glyph = font.glyphs[i];
+    offsets[i] = offset;
+    rotateGlyph(glyphRows(font, glyph), glyph.width, glyph.height,
+                columns + offset);
+    offset += glyph.width * ((glyph.height + 7) >> 3);
+  }
+
+  cache.font = &font;
+  cache.columns = columns;
+  cache.offsets = offsets;
+  return true;
+}
+
+const uint8_t *glyphColumns(const Font &font, const Glyph &glyph) {
+  if (font.columns) {
+    return font.columns + glyph.columns;
+  }
+  if (font.packed) {
+    const GlyphSlot *slot = cachedGlyph(font, glyph);
+    return slot ? slot->columns : nullptr;
+  }
+  for (int i = 0; i < MAX_COLUMN_FONTS; i++) {
+    ColumnGlyphCache &cache = g_columnCache[i];
+    if (cache.font == &font) {
+      return cache.columns + cache.offsets[&glyph - font.glyphs];
+    }
+    if (cache.font == nullptr) {
+      if (!buildColumnCache(font, cache)) {
+        Serial.println("ERROR: Cannot build column glyph cache");
+        return nullptr;
+      }
+      return cache.columns + cache.offsets[&glyph - font.glyphs];
+    }
+  }
+  Serial.println("ERROR: Column glyph cache full");
+  return nullptr;
+}
+
+// ============================================================================
+// PRINTER-FORMAT RENDERING
+// ============================================================================
+
+// OR the glyph's columns that fall inside the window; returns false when
+// nothing was drawn. [x1, x2) receives the columns written.
+static bool drawGlyphColumns(const ColumnWindow &window, const Font &font,
+                             const Glyph &glyph, int x, int y, int &x1,
+                             int &x2) {
+  x1 = x + glyph.left;
+  x2 = x1 + glyph.width;
+  const int gx = x1;
+  if (x1 < window.x1)
+    x1 = window.x1;
+  if (x2 > window.x2)
+    x2 = window.x2;
+  if (x1 >= x2 || glyph.height == 0) {
+    return false;
+  }
+
+  const uint8_t *columns = glyphColumns(font, glyph);
+  if (!columns) {
+    return false;
+  }
+
+  const int columnBytes = (glyph.height + 7) >> 3;
+  for (int cx = x1; cx < x2; cx++) {
+    orColumnBits(window.data + (cx - window.x1) * window.bytesPerColumn,
+                 y + glyph.top, columns + (cx - gx) * columnBytes,
+                 glyph.height, window.y1, window.y2);
+  }
+  return true;
+}
+
+int drawTextColumns(const ColumnWindow &window, const Font &font,
+                    const char *str, int x, int y) {
+  int x1, x2;
+  while (*str) {
+    const Glyph &glyph = findGlyph(font, nextCodepoint(str));
+    drawGlyphColumns(window, font, glyph, x, y, x1, x2);
+    x += glyph.advance;
+  }
+  return x;
+}
+
+// The whole canvas, restricted to its clip rectangle
+template <int W, int H>
+static ColumnWindow canvasWindow(PrinterBitmap<W, H> &bitmap) {
+  const ClipRect &clip = bitmap.clip.rect;
+  ColumnWindow window = {bitmapColumn(bitmap, clip.x1), clip.x1, clip.x2,
+                         clip.y1, clip.y2,
+                         PrinterBitmap<W, H>::BYTES_PER_COLUMN};
+  return window;
+}
+
+template <int W, int H>
+int drawGlyph(PrinterBitmap<W, H> &bitmap, const Font &font,
+              uint32_t codepoint, int x, int y) {
+  const Glyph &glyph = findGlyph(font, codepoint);
+  int x1, x2;
+  if (drawGlyphColumns(canvasWindow(bitmap), font, glyph, x, y, x1, x2)) {
+    markDirty(bitmap, x1, x2);
+  }
+  return glyph.advance;
+}
+
+template <int W, int H>
+int drawText(PrinterBitmap<W, H> &bitmap, const Font &font, const char *str,
+             int x, int y) {
+  const ColumnWindow window = canvasWindow(bitmap);
+  int x1, x2;
+  while (*str) {
+    const Glyph &glyph = findGlyph(font, nextCodepoint(str));
+    if (drawGlyphColumns(window, font, glyph, x, y, x1, x2)) {
+      markDirty(bitmap, x1, x2);
+    }
+    x += glyph.advance;
+  }
+  return x;
+}
+
+// ============================================================================
+// SCALED RENDERING
+// ============================================================================
+
+template <typename BitmapT>
+static int drawScaled(BitmapT &bitmap, const Font &font, const Glyph &glyph,
+                      int x, int y, int scale) {
+  const uint8_t *rows = glyph.width > 0 ? glyphRows(font, glyph) : nullptr;
+  if (!rows) {
+    return glyph.advance * scale;
+  }
+
+  const int stride = (glyph.width + 7) >> 3;
+  const int left = x + glyph.left * scale;
+  for (int r = 0; r < glyph.height; r++) {
+    const uint8_t *row = rows + r * stride;
+    const int top = y + (glyph.top + r) * scale;
+    int c = 0;
+    while (c < glyph.width) {
+      // Skip clear pixels, then take the run of set ones
+      while (c < glyph.width && !(row[c >> 3] & (0x80 >> (c & 7)))) {
+        c++;
+      }
+      const int start = c;
+      while (c < glyph.width && (row[c >> 3] & (0x80 >> (c & 7)))) {
+        c++;
+      }
+      if (start < c) {
+        for (int k = 0; k < scale; k++) {
+          fillSpan(bitmap, top + k, left + start * scale, left + c * scale,
+                   true);
+        }
+      }
+    }
+  }
+  return glyph.advance * scale;
+}
+
+template <int W, int H>
+int drawGlyphScaled(BasicBitmap<W, H> &bitmap, const Font &font,
+                    uint32_t codepoint, int x, int y, int scale) {
+  return drawScaled(bitmap, font, findGlyph(font, codepoint), x, y, scale);
+}
+
+template <int W, int H>
+int drawTextScaled(BasicBitmap<W, H> &bitmap, const Font &font,
+                   const char *str, int x, int y, int scale) {
+  while (*str) {
+    x += drawScaled(bitmap, font, findGlyph(font, nextCodepoint(str)), x, y,
+                    scale);
+  }
+  return x;
+}
+
+template <int W, int H>
+int drawGlyphScaled(PrinterBitmap<W, H> &bitmap, const Font &font,
+                    uint32_t codepoint, int x, int y, int scale) {
+  return drawScaled(bitmap, font, findGlyph(font, codepoint), x, y, scale);
+}
+
+template <int W, int H>
+int drawTextScaled(PrinterBitmap<W, H> &bitmap, const Font &font,
+                   const char *str, int x, int y, int scale) {
+  while (*str) {
+    x += drawScaled(bitmap, font, findGlyph(font, nextCodepoint(str)), x, y,
+                    scale);
+  }
+  return x;
+}
+
+// ============================================================================
+// TEXT-ONLY LABELS
+// ============================================================================
+
+void textInkColumns(const Font &font, const char *str, int x, int &x1,
+                    int &x2) {
+  x1 = x;
+  x2 = x;
+  bool empty = true;
+  while (*str) {
+    const Glyph &glyph = findGlyph(font, nextCodepoint(str));
+    if (glyph.width > 0) {
+      const int left = x + glyph.left;
+      const int right = left + glyph.width;
+      if (empty || left < x1)
+        x1 = left;
+      if (empty || right > x2)
+        x2 = right;
+      empty = false;
+    }
+    x += glyph.advance;
+  }
+}
+
+template <int W, int H>
+void renderTextColumns(const TextLabel<W, H> &label, int startCol, int width,
+                       uint8_t *dest) {
+  clearBuffer(dest, width * TextLabel<W, H>::BYTES_PER_COLUMN);
+
+  const ColumnWindow window = {dest, startCol, startCol + width, 0, H,
+                               TextLabel<W, H>::BYTES_PER_COLUMN};
+  for (int i = 0; i < label.runCount; i++) {
+    const TextRun &run = label.runs[i];
+    drawTextColumns(window, *run.font, run.text, run.x, run.y);
+  }
+}
+
+// ============================================================================
+// EXPLICIT INSTANTIATIONS (one per tape canvas)
+// ============================================================================
+
+#define INSTANTIATE_FONT(W, H)                                                 \
+  template int drawGlyph(BasicBitmap<W, H> &, const Font &, uint32_t, int,     \
+                         int);                                                 \
+  template int drawText(BasicBitmap<W, H> &, const Font &, const char *, int,  \
+                        int);                                                  \
+  template int drawGlyph(PrinterBitmap<W, H> &, const Font &, uint32_t, int,   \
+                         int);                                                 \
+  template int drawText(PrinterBitmap<W, H> &, const Font &, const char *,     \
+                        int, int);                                             \
+  template int drawGlyphScaled(BasicBitmap<W, H> &, const Font &, uint32_t,    \
+                               int, int, int);                                 \
+  template int drawTextScaled(BasicBitmap<W, H> &, const Font &, const char *, \
+                              int, int, int);                                  \
+  template int drawGlyphScaled(PrinterBitmap<W, H> &, const Font &, uint32_t,  \
+                               int, int, int);                                 \
+  template int drawTextScaled(PrinterBitmap<W, H> &, const Font &,             \
+                              const char *, int, int, int);                    \
+  template void renderTextColumns(const TextLabel<W, H> &, int, int,           \
+                                  uint8_t *);
+
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_FONT)
+
+#undef INSTANTIATE_FONT
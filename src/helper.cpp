@@ -1,20 +1,127 @@
+#include <cstring>
 #include <helper.h>
 
-void clearBuffer(uint8_t *buf, size_t len) {
-  for (size_t i = 0; i < len; i++) {
-    buf[i] = 0;
-  }
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ============================================================================
+// BULK BUFFER KERNELS
+// Clear, fill and copy go to the C library, which is never slower than a byte
+// loop. Invert has no library equivalent: host builds run bytes up to a 32-bit
+// boundary, then 32-byte AVX2 or 16-byte SSE2 vectors, then 32-bit words,
+// then the remaining bytes. The ESP32 keeps the byte loop until a word loop
+// has been timed on the board. tools/bench_buffers.cpp times these kernels
+// against byte loops.
+// ============================================================================
+
+void clearBuffer(uint8_t *buf, size_t len) { memset(buf, 0x00, len); }
+
+void fillBuffer(uint8_t *buf, size_t len, uint8_t value) {
+  memset(buf, value, len);
 }
 
-// Pure function: Copy buffer
+// Pure function: Copy buffer (buffers must not overlap)
 void copyBuffer(uint8_t *dst, const uint8_t *src, size_t len) {
-  for (size_t i = 0; i < len; i++) {
-    dst[i] = src[i];
+  memcpy(dst, src, len);
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+// Word type allowed to alias the uint8_t buffers it is used on
+typedef uint32_t __attribute__((__may_alias__)) BufferWord;
+#endif
+
+void invertBuffer(uint8_t *buf, size_t len) {
+  size_t i = 0;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+  const size_t misalign = (uintptr_t)buf & (sizeof(BufferWord) - 1);
+  i = misalign ? sizeof(BufferWord) - misalign : 0;
+  if (i > len)
+    i = len;
+  for (size_t j = 0; j < i; j++) {
+    buf[j] ^= 0xFF;
+  }
+
+#if defined(__AVX2__)
+  const __m256i ones = _mm256_set1_epi8((char)0xFF);
+  for (; i + 32 <= len; i += 32) {
+    __m256i *p = (__m256i *)(buf + i);
+    _mm256_storeu_si256(p, _mm256_xor_si256(_mm256_loadu_si256(p), ones));
+  }
+#else
+  const __m128i ones = _mm_set1_epi8((char)0xFF);
+  for (; i + 16 <= len; i += 16) {
+    __m128i *p = (__m128i *)(buf + i);
+    _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), ones));
+  }
+#endif
+
+  for (; i + 4 <= len; i += 4) {
+    *(BufferWord *)(buf + i) ^= 0xFFFFFFFFu;
+  }
+#endif
+
+  for (; i < len; i++) {
+    buf[i] ^= 0xFF;
   }
 }
 
-// Pure function: Calculate pixel index from coordinates
-int pixelToIndex(int x, int y) { return y * IMAGE_WIDTH + x; }
+// Hacker's Delight transpose8: three rounds of delta swaps exchange 1x1, 2x2
+// and 4x4 sub-blocks across the diagonal. 64-bit hosts hold the whole block
+// in one register; the ESP32 splits it into two 32-bit halves.
+void transposeBits8x8(const uint8_t *src, int srcStride, uint8_t *dst,
+                      int dstStride) {
+#if UINTPTR_MAX > 0xFFFFFFFFu
+  uint64_t x = 0;
+  for (int r = 0; r < 8; r++) {
+    x = (x << 8) | src[r * srcStride];
+  }
+  uint64_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+  x = x ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+  x = x ^ t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+  x = x ^ t ^ (t << 28);
+  for (int r = 7; r >= 0; r--) {
+    dst[r * dstStride] = (uint8_t)x;
+    x >>= 8;
+  }
+#else
+  uint32_t x = ((uint32_t)src[0] << 24) | ((uint32_t)src[srcStride] << 16) |
+               ((uint32_t)src[2 * srcStride] << 8) | src[3 * srcStride];
+  uint32_t y = ((uint32_t)src[4 * srcStride] << 24) |
+               ((uint32_t)src[5 * srcStride] << 16) |
+               ((uint32_t)src[6 * srcStride] << 8) | src[7 * srcStride];
+  uint32_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AAu;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AAu;
+  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCCu;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCCu;
+  y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0u) | ((y >> 4) & 0x0F0F0F0Fu);
+  y = ((x << 4) & 0xF0F0F0F0u) | (y & 0x0F0F0F0Fu);
+  x = t;
+  dst[0] = x >> 24;
+  dst[dstStride] = x >> 16;
+  dst[2 * dstStride] = x >> 8;
+  dst[3 * dstStride] = x;
+  dst[4 * dstStride] = y >> 24;
+  dst[5 * dstStride] = y >> 16;
+  dst[6 * dstStride] = y >> 8;
+  dst[7 * dstStride] = y;
+#endif
+}
+
+// Pure function: Calculate pixel (bit) index from coordinates, rows are
+// BITMAP_STRIDE bytes apart
+int pixelToIndex(int x, int y) { return y * BITMAP_STRIDE * 8 + x; }
 
 // Pure function: Calculate byte index from pixel index
 int indexToByte(int idx) { return idx / 8; }
@@ -26,12 +133,21 @@ int indexToBit(int idx) { return idx % 8; }
 uint8_t bitMask(int bitPos) { return 0x80 >> bitPos; }
 
 // Pure function: Check if pixel is black
-bool isPixelBlack(const Bitmap &bitmap, int x, int y) {
-  if (x < 0 || x >= IMAGE_WIDTH || y < 0 || y >= IMAGE_HEIGHT) {
+template <int W, int H>
+bool isPixelBlack(const BasicBitmap<W, H> &bitmap, int x, int y) {
+  if (x < 0 || x >= W || y < 0 || y >= H) {
     return false;
   }
-  const int idx = pixelToIndex(x, y);
-  return bitmap.data[indexToByte(idx)] & bitMask(indexToBit(idx));
+  return bitmapRow(bitmap, y)[x >> 3] & bitMask(x & 7);
+}
+
+// Pure function: Check if pixel is black (printer-format canvas)
+template <int W, int H>
+bool isPixelBlack(const PrinterBitmap<W, H> &bitmap, int x, int y) {
+  if (x < 0 || x >= W || y < 0 || y >= H) {
+    return false;
+  }
+  return bitmapColumn(bitmap, x)[columnByteIndex(y)] & columnBitMask(y);
 }
 
 // Pure function: Calculate checksum
@@ -42,3 +158,15 @@ uint8_t calculateChecksum(const uint8_t *data, size_t len) {
   }
   return checksum;
 }
+
+// ============================================================================
+// EXPLICIT INSTANTIATIONS (one per tape canvas)
+// ============================================================================
+
+#define INSTANTIATE_HELPER(W, H)                                               \
+  template bool isPixelBlack(const BasicBitmap<W, H> &, int, int);             \
+  template bool isPixelBlack(const PrinterBitmap<W, H> &, int, int);
+
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_HELPER)
+
+#undef INSTANTIATE_HELPER
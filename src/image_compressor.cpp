@@ -5,9 +5,26 @@
 // GLOBAL HEAP BUFFERS (initialized by initCompression())
 // ========================================================
 
+// Sized for the largest tape canvas so every instantiation can share them
+#define MAX_CHUNK_BYTES (DEFAULT_CHUNK_WIDTH * Bitmap16mm::BYTES_PER_COLUMN)
+// LZO1X worst case for one chunk
+#define MAX_COMPRESSED_CHUNK_SIZE                                              \
+  (MAX_CHUNK_BYTES + MAX_CHUNK_BYTES / 16 + 64 + 3)
+// All tape canvases are IMAGE_WIDTH wide, so they share a chunk count
+#define MAX_CHUNK_COUNT (Bitmap::CHUNK_COUNT)
+
 static uint8_t *g_lzoWorkMem = nullptr;
-static uint8_t *g_compressed = nullptr;
-static Bitmap *g_printerFormatBuffer = nullptr;
+// One chunk of printer-format columns, filled straight from a row-major
+// bitmap. PrinterBitmap canvases are compressed in place and skip it.
+static uint8_t *g_chunkBuffer = nullptr;
+
+// Compressed payload of every chunk of the last canvas compressed (one
+// MAX_COMPRESSED_CHUNK_SIZE slot per chunk). When the same canvas comes back,
+// chunks outside its dirty range are sent again without recompressing.
+static uint8_t *g_chunkCache = nullptr;
+static lzo_uint g_chunkCacheLen[MAX_CHUNK_COUNT];
+static bool g_chunkCacheValid[MAX_CHUNK_COUNT];
+static const void *g_chunkCacheOwner = nullptr;
 
 // ========================================================
 // COMPRESSION LIFECYCLE
@@ -15,22 +32,26 @@ static Bitmap *g_printerFormatBuffer = nullptr;
 
 bool initCompression() {
   g_lzoWorkMem = (uint8_t *)malloc(LZO1X_1_MEM_COMPRESS);
-  g_compressed = (uint8_t *)malloc(MAX_COMPRESSED_SIZE);
-  g_printerFormatBuffer = (Bitmap *)malloc(sizeof(Bitmap));
+  g_chunkBuffer = (uint8_t *)malloc(MAX_CHUNK_BYTES);
+  g_chunkCache =
+      (uint8_t *)malloc(MAX_CHUNK_COUNT * MAX_COMPRESSED_CHUNK_SIZE);
 
-  if (!g_lzoWorkMem || !g_compressed || !g_printerFormatBuffer) {
+  if (!g_lzoWorkMem || !g_chunkBuffer || !g_chunkCache) {
     free(g_lzoWorkMem);
-    free(g_compressed);
-    free(g_printerFormatBuffer);
+    free(g_chunkBuffer);
+    free(g_chunkCache);
     g_lzoWorkMem = nullptr;
-    g_compressed = nullptr;
-    g_printerFormatBuffer = nullptr;
+    g_chunkBuffer = nullptr;
+    g_chunkCache = nullptr;
     return false;
   }
 
   memset(g_lzoWorkMem, 0, LZO1X_1_MEM_COMPRESS);
-  memset(g_compressed, 0, MAX_COMPRESSED_SIZE);
-  clearBuffer(g_printerFormatBuffer->data, BITMAP_SIZE);
+  clearBuffer(g_chunkBuffer, MAX_CHUNK_BYTES);
+  for (int i = 0; i < MAX_CHUNK_COUNT; i++) {
+    g_chunkCacheValid[i] = false;
+  }
+  g_chunkCacheOwner = nullptr;
 
   return true;
 }
@@ -38,144 +59,231 @@ bool initCompression() {
 void cleanupCompression() {
   free(g_lzoWorkMem);
   g_lzoWorkMem = nullptr;
-  free(g_compressed);
-  g_compressed = nullptr;
-  free(g_printerFormatBuffer);
-  g_printerFormatBuffer = nullptr;
+  free(g_chunkBuffer);
+  g_chunkBuffer = nullptr;
+  free(g_chunkCache);
+  g_chunkCache = nullptr;
+  g_chunkCacheOwner = nullptr;
 }
 
 // ========================================================
 // BITMAP TRANSFORMS
 // ========================================================
 
-void transformToColumnMajor(const Bitmap &source, Bitmap &dest) {
-  clearBuffer(dest.data, BITMAP_SIZE);
-
-  for (int x = 0; x < IMAGE_WIDTH; x++) {
-    for (int y = 0; y < IMAGE_HEIGHT; y++) {
-      if (isPixelBlack(source, x, y)) {
-        int col = x * BYTES_PER_COLUMN;
-        int row = (IMAGE_HEIGHT - 1 - y) / 8;
-        int bit = (IMAGE_HEIGHT - 1 - y) % 8;
-        int idx = col + row;
-
-        if (idx >= 0 && idx < BITMAP_SIZE) {
-          dest.data[idx] |= (1 << bit);
-        }
+// Each 8x8 block of the canvas, transposed, is one byte of each of its eight
+// columns: the transforms below are one transposeBits8x8 per block.
+
+// Columns [startCol, startCol + width) in printer format (column-major plus
+// 16-bit swap in one pass), written to dest at BYTES_PER_COLUMN per column
+template <int W, int H>
+static void printerFormatColumns(const BasicBitmap<W, H> &source,
+                                 int startCol, int width, uint8_t *dest) {
+  const int bytesPerColumn = BasicBitmap<W, H>::BYTES_PER_COLUMN;
+  const int endCol = startCol + width;
+  uint8_t columns[8];
+
+  for (int bx = startCol & ~7; bx < endCol; bx += 8) {
+    const int c1 = startCol > bx ? startCol - bx : 0;
+    const int c2 = endCol < bx + 8 ? endCol - bx : 8;
+    for (int k = 0; k < bytesPerColumn; k++) {
+      transposeBits8x8(bitmapRow(source, 8 * k) + (bx >> 3),
+                       BasicBitmap<W, H>::STRIDE, columns, 1);
+      uint8_t *out = dest + (bx - startCol) * bytesPerColumn + (k ^ 1);
+      for (int c = c1; c < c2; c++) {
+        out[c * bytesPerColumn] = columns[c];
       }
     }
   }
 }
 
-// 16-bit row swap (height assumed multiple of 8)
-void transform16BitSwap(Bitmap &bitmap) {
-  uint8_t *temp = (uint8_t *)malloc(BITMAP_SIZE);
-  if (!temp)
-    return;
-
-  copyBuffer(temp, bitmap.data, BITMAP_SIZE);
-
-  for (int col = 0; col < IMAGE_WIDTH; col++) {
-    int s = col * BYTES_PER_COLUMN;
-
-    for (int i = 0; i < BYTES_PER_COLUMN; i += 2) {
-      int dst = s + i;
-      int src = s + (BYTES_PER_COLUMN - 2 - i);
-
-      if (dst + 1 < BITMAP_SIZE && src + 1 < BITMAP_SIZE) {
-        bitmap.data[dst] = temp[src];
-        bitmap.data[dst + 1] = temp[src + 1];
+// Bottom row first: byte j of a column holds rows H - 8j - 8 to H - 8j - 1,
+// the topmost in the MSB
+template <int W, int H>
+void transformToColumnMajor(const BasicBitmap<W, H> &source,
+                            BasicBitmap<W, H> &dest) {
+  const int bytesPerColumn = BasicBitmap<W, H>::BYTES_PER_COLUMN;
+  clearBuffer(dest.data, BasicBitmap<W, H>::SIZE);
+  markAllDirty(dest);
+  uint8_t columns[8];
+
+  for (int bx = 0; bx < W; bx += 8) {
+    const int count = W - bx < 8 ? W - bx : 8;
+    for (int k = 0; k < bytesPerColumn; k++) {
+      transposeBits8x8(bitmapRow(source, 8 * k) + (bx >> 3),
+                       BasicBitmap<W, H>::STRIDE, columns, 1);
+      uint8_t *out = dest.data + bx * bytesPerColumn + bytesPerColumn - 1 - k;
+      for (int c = 0; c < count; c++) {
+        out[c * bytesPerColumn] = columns[c];
       }
     }
   }
+}
+
+// 16-bit row swap: reverse the order of the 16-bit words in every column, in
+// place (height is a multiple of 16, enforced by CanvasGeometry)
+template <int W, int H> void transform16BitSwap(BasicBitmap<W, H> &bitmap) {
+  const int bytesPerColumn = BasicBitmap<W, H>::BYTES_PER_COLUMN;
+  markAllDirty(bitmap);
+
+  for (int col = 0; col < W; col++) {
+    uint8_t *s = bitmap.data + col * bytesPerColumn;
+
+    for (int i = 0; i < bytesPerColumn - 2 - i; i += 2) {
+      const int j = bytesPerColumn - 2 - i;
+      uint8_t lo = s[i];
+      uint8_t hi = s[i + 1];
+      s[i] = s[j];
+      s[i + 1] = s[j + 1];
+      s[j] = lo;
+      s[j + 1] = hi;
+    }
+  }
+}
 
-  free(temp);
+template <int W, int H>
+void transformToPrinterFormat(const BasicBitmap<W, H> &source,
+                              BasicBitmap<W, H> &dest) {
+  printerFormatColumns(source, 0, W, dest.data);
+  markAllDirty(dest);
 }
 
-void transformToPrinterFormat(const Bitmap &source, Bitmap &dest) {
-  transformToColumnMajor(source, dest);
-  transform16BitSwap(dest);
+template <int W, int H>
+void transformToPrinterFormat(const BasicBitmap<W, H> &source,
+                              PrinterBitmap<W, H> &dest) {
+  printerFormatColumns(source, 0, W, dest.data);
+  markAllDirty(dest);
 }
 
 // ========================================================
 // COMPRESSION + FRAME GENERATION
 // ========================================================
 
-std::vector<PrinterFrame> compressAndGenerateFrames(const Bitmap &userBitmap,
-                                                    uint16_t mtu) {
-  std::vector<PrinterFrame> frames;
-
-  if (!g_printerFormatBuffer || !g_lzoWorkMem || !g_compressed) {
-    Serial.println("ERROR: Compression not initialized");
-    return frames;
+// Wrap one chunk's compressed payload in a frame and append it, split to
+// the MTU
+static void appendChunkFrames(std::vector<PrinterFrame> &frames,
+                              const uint8_t *compressed, size_t compressedLen,
+                              int chunkWidth, uint16_t framesRemaining,
+                              uint16_t bitmapWidth, uint16_t mtu) {
+  auto fullFrame = createBLEFrame(compressed, compressedLen, framesRemaining,
+                                  chunkWidth, bitmapWidth);
+
+  size_t idx = 0;
+  bool first = true;
+
+  while (idx < fullFrame.size()) {
+    PrinterFrame f;
+    size_t sz = std::min((size_t)mtu, fullFrame.size() - idx);
+
+    f.data.assign(fullFrame.begin() + idx, fullFrame.begin() + idx + sz);
+    f.chunkWidth = chunkWidth;
+    f.framesRemaining = framesRemaining;
+    f.isContinuation = !first;
+
+    frames.push_back(f);
+    first = false;
+    idx += sz;
   }
+}
 
-  transformToPrinterFormat(userBitmap, *g_printerFormatBuffer);
-
-  int chunks = (IMAGE_WIDTH + DEFAULT_CHUNK_WIDTH - 1) / DEFAULT_CHUNK_WIDTH;
-  int remainder = IMAGE_WIDTH - (chunks - 1) * DEFAULT_CHUNK_WIDTH;
-
-  uint8_t *chunkBuffer =
-      (uint8_t *)malloc(BYTES_PER_COLUMN * DEFAULT_CHUNK_WIDTH);
-  if (!chunkBuffer)
-    return frames;
+// Printer-format columns of one chunk. Row-major canvases are converted into
+// g_chunkBuffer; printer-format canvases already hold them contiguously.
+template <int W, int H>
+static const uint8_t *chunkColumns(const BasicBitmap<W, H> &bitmap,
+                                   int startCol, int width) {
+  printerFormatColumns(bitmap, startCol, width, g_chunkBuffer);
+  return g_chunkBuffer;
+}
 
-  int columnOffset = 0;
-  int framesRemaining = chunks - 1;
+template <int W, int H>
+static const uint8_t *chunkColumns(const PrinterBitmap<W, H> &bitmap,
+                                   int startCol, int /* width */) {
+  return bitmapColumn(bitmap, startCol);
+}
 
-  for (int chunkIdx = 0; chunkIdx < chunks; chunkIdx++) {
-    int chunkWidth = (chunkIdx == chunks - 1) ? remainder : DEFAULT_CHUNK_WIDTH;
+template <int W, int H>
+static const uint8_t *chunkColumns(const TextLabel<W, H> &label, int startCol,
+                                   int width) {
+  renderTextColumns(label, startCol, width, g_chunkBuffer);
+  return g_chunkBuffer;
+}
 
-    int chunkBytes = chunkWidth * BYTES_PER_COLUMN;
-    int byteOffset = columnOffset * BYTES_PER_COLUMN;
+template <typename BitmapT>
+static std::vector<PrinterFrame> generateFrames(const BitmapT &userBitmap,
+                                                uint16_t mtu) {
+  static_assert(BitmapT::CHUNK_COUNT <= MAX_CHUNK_COUNT,
+                "chunk cache too small for this canvas");
+  std::vector<PrinterFrame> frames;
 
-    memset(chunkBuffer, 0, chunkBytes);
+  if (!g_chunkBuffer || !g_lzoWorkMem || !g_chunkCache) {
+    Serial.println("ERROR: Compression not initialized");
+    return frames;
+  }
 
-    for (int i = 0; i < chunkBytes && (byteOffset + i) < BITMAP_SIZE; i++) {
-      chunkBuffer[i] = g_printerFormatBuffer->data[byteOffset + i];
+  const bool sameCanvas = g_chunkCacheOwner == &userBitmap;
+  int columnOffset = 0;
+  int framesRemaining = BitmapT::CHUNK_COUNT - 1;
+
+  for (int chunkIdx = 0; chunkIdx < BitmapT::CHUNK_COUNT; chunkIdx++) {
+    int chunkWidth = (chunkIdx == BitmapT::CHUNK_COUNT - 1)
+                         ? BitmapT::LAST_CHUNK_WIDTH
+                         : DEFAULT_CHUNK_WIDTH;
+    uint8_t *slot = g_chunkCache + chunkIdx * MAX_COMPRESSED_CHUNK_SIZE;
+
+    const bool reuse =
+        sameCanvas && g_chunkCacheValid[chunkIdx] &&
+        !isDirty(userBitmap, columnOffset, columnOffset + chunkWidth);
+
+    if (!reuse) {
+      const uint8_t *columns =
+          chunkColumns(userBitmap, columnOffset, chunkWidth);
+      const int chunkBytes = chunkWidth * BitmapT::BYTES_PER_COLUMN;
+      int res = lzo1x_1_compress(columns, chunkBytes, slot,
+                                 &g_chunkCacheLen[chunkIdx], g_lzoWorkMem);
+      g_chunkCacheValid[chunkIdx] = (res == LZO_E_OK);
     }
 
-    lzo_uint compressedLen = 0;
-    int res = lzo1x_1_compress(chunkBuffer, chunkBytes, g_compressed,
-                               &compressedLen, g_lzoWorkMem);
-
-    if (res != LZO_E_OK) {
+    if (g_chunkCacheValid[chunkIdx]) {
+      appendChunkFrames(frames, slot, g_chunkCacheLen[chunkIdx], chunkWidth,
+                        framesRemaining, BitmapT::WIDTH, mtu);
+    } else {
       Serial.printf("Compression failed (chunk %d)\n", chunkIdx);
-      continue;
-    }
-
-    auto fullFrame = createBLEFrame(g_compressed, compressedLen,
-                                    framesRemaining, chunkWidth);
-
-    size_t idx = 0;
-    bool first = true;
-
-    while (idx < fullFrame.size()) {
-      PrinterFrame f;
-      size_t sz = std::min((size_t)mtu, fullFrame.size() - idx);
-
-      f.data.assign(fullFrame.begin() + idx, fullFrame.begin() + idx + sz);
-      f.chunkWidth = chunkWidth;
-      f.framesRemaining = framesRemaining;
-      f.isContinuation = !first;
-
-      frames.push_back(f);
-      first = false;
-      idx += sz;
     }
 
     framesRemaining--;
     columnOffset += chunkWidth;
   }
 
-  free(chunkBuffer);
+  g_chunkCacheOwner = &userBitmap;
+  markClean(userBitmap);
   return frames;
 }
 
+template <int W, int H>
+std::vector<PrinterFrame>
+compressAndGenerateFrames(const BasicBitmap<W, H> &userBitmap, uint16_t mtu) {
+  return generateFrames(userBitmap, mtu);
+}
+
+// Printer-format canvases are already laid out as the printer expects, so
+// each chunk's columns go straight to LZO
+template <int W, int H>
+std::vector<PrinterFrame>
+compressAndGenerateFrames(const PrinterBitmap<W, H> &userBitmap,
+                          uint16_t mtu) {
+  return generateFrames(userBitmap, mtu);
+}
+
+template <int W, int H>
+std::vector<PrinterFrame>
+compressAndGenerateFrames(const TextLabel<W, H> &label, uint16_t mtu) {
+  return generateFrames(label, mtu);
+}
+
 std::vector<uint8_t> createBLEFrame(const uint8_t *compressedData,
                                     size_t compressedSize,
                                     uint16_t framesRemaining,
-                                    uint8_t chunkWidth) {
+                                    uint8_t chunkWidth,
+                                    uint16_t bitmapWidth) {
   std::vector<uint8_t> frame;
 
   frame.push_back(0x66);
@@ -187,8 +295,8 @@ std::vector<uint8_t> createBLEFrame(const uint8_t *compressedData,
   const uint8_t CMD[] = {0x1B, 0x2F, 0x03, 0x01, 0x00, 0x01, 0x00, 0x01};
   frame.insert(frame.end(), CMD, CMD + 8);
 
-  frame.push_back(IMAGE_WIDTH & 0xFF);
-  frame.push_back(IMAGE_WIDTH >> 8);
+  frame.push_back(bitmapWidth & 0xFF);
+  frame.push_back(bitmapWidth >> 8);
 
   frame.push_back(chunkWidth);
   frame.push_back(framesRemaining >> 8);
@@ -204,3 +312,26 @@ std::vector<uint8_t> createBLEFrame(const uint8_t *compressedData,
 
   return frame;
 }
+
+// ========================================================
+// EXPLICIT INSTANTIATIONS (one per tape canvas)
+// ========================================================
+
+#define INSTANTIATE_IMAGE_COMPRESSOR(W, H)                                     \
+  template void transformToPrinterFormat(const BasicBitmap<W, H> &,            \
+                                         BasicBitmap<W, H> &);                 \
+  template void transformToPrinterFormat(const BasicBitmap<W, H> &,            \
+                                         PrinterBitmap<W, H> &);               \
+  template void transformToColumnMajor(const BasicBitmap<W, H> &,              \
+                                       BasicBitmap<W, H> &);                   \
+  template void transform16BitSwap(BasicBitmap<W, H> &);                       \
+  template std::vector<PrinterFrame> compressAndGenerateFrames(                \
+      const BasicBitmap<W, H> &, uint16_t);                                    \
+  template std::vector<PrinterFrame> compressAndGenerateFrames(                \
+      const PrinterBitmap<W, H> &, uint16_t);                                  \
+  template std::vector<PrinterFrame> compressAndGenerateFrames(                \
+      const TextLabel<W, H> &, uint16_t);
+
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_IMAGE_COMPRESSOR)
+
+#undef INSTANTIATE_IMAGE_COMPRESSOR
@@ -0,0 +1,216 @@
+#include <image_scaler.h>
+#include <cstring>
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+bool fitImage(int sourceWidth, int sourceHeight, int height, int &fitWidth,
+              int &fitHeight) {
+  if (sourceWidth < 1 || sourceHeight < 1 || height < 1 ||
+      (uint64_t)sourceWidth * sourceHeight > MAX_SCALE_SOURCE_PIXELS) {
+    return false;
+  }
+  int64_t width =
+      ((int64_t)sourceWidth * height + sourceHeight / 2) / sourceHeight;
+  if (width > MAX_DITHER_WIDTH) {
+    width = MAX_DITHER_WIDTH;
+    height = (int)(((int64_t)sourceHeight * width + sourceWidth / 2) /
+                   sourceWidth);
+  }
+  fitWidth = width > 0 ? (int)width : 1;
+  fitHeight = height > 0 ? height : 1;
+  return true;
+}
+
+bool startImageScaler(ImageScaler &scaler, int sourceWidth, int sourceHeight,
+                      int x, int y, int height, DitherMethod method) {
+  int width;
+  if (!fitImage(sourceWidth, sourceHeight, height, width, height) ||
+      !startDither(scaler.ditherer, method, x, y, width)) {
+    return false;
+  }
+  scaler.sourceWidth = sourceWidth;
+  scaler.sourceHeight = sourceHeight;
+  scaler.width = width;
+  scaler.height = height;
+  scaler.sourceRow = 0;
+  scaler.outputRow = 0;
+  memset(scaler.sums, 0, sizeof(scaler.sums));
+
+  if (width < sourceWidth) {
+    scaler.columnScale = sourceWidth;
+  } else {
+    // Nearest source pixel to each output pixel centre
+    scaler.columnScale = 1;
+    for (int j = 0; j < width; j++) {
+      scaler.sampleColumns[j] = (2 * j + 1) * sourceWidth / (2 * width);
+    }
+  }
+  return true;
+}
+
+// ============================================================================
+// RESAMPLING
+// Area weights are integers in units of 1/(output size) of a source pixel:
+// source pixel i spans [i * width, (i + 1) * width) and output pixel j spans
+// [j * sourceWidth, (j + 1) * sourceWidth), likewise for rows. An output
+// pixel's weights then sum to sourceWidth * sourceHeight, and nothing is
+// rounded until that division.
+// ============================================================================
+
+// Resize one source row into scaler.columns (scaled by columnScale)
+static void scaleColumns(ImageScaler &scaler, const uint8_t *source) {
+  uint32_t *columns = scaler.columns;
+  if (scaler.width >= scaler.sourceWidth) {
+    for (int j = 0; j < scaler.width; j++) {
+      columns[j] = source[scaler.sampleColumns[j]];
+    }
+    return;
+  }
+
+  // Shrinking, each source pixel crosses at most one output boundary
+  const uint32_t unit = scaler.width;
+  const uint32_t span = scaler.sourceWidth;
+  uint32_t position = 0;
+  uint32_t boundary = span;
+  uint32_t sum = 0;
+  for (int i = 0; i < scaler.sourceWidth; i++) {
+    const uint32_t value = source[i];
+    const uint32_t end = position + unit;
+    if (end < boundary) {
+      sum += unit * value;
+    } else {
+      *columns++ = sum + (boundary - position) * value;
+      sum = (end - boundary) * value;
+      boundary += span;
+    }
+    position = end;
+  }
+}
+
+template <typename BitmapT>
+static void finishRow(BitmapT &bitmap, ImageScaler &scaler,
+                      const uint32_t *values, uint32_t divisor) {
+  if (divisor == 1) {
+    for (int j = 0; j < scaler.width; j++) {
+      scaler.row[j] = values[j];
+    }
+  } else {
+    const uint32_t half = divisor / 2;
+    for (int j = 0; j < scaler.width; j++) {
+      scaler.row[j] = (values[j] + half) / divisor;
+    }
+  }
+  ditherRow(bitmap, scaler.ditherer, scaler.row);
+  scaler.outputRow++;
+}
+
+template <typename BitmapT>
+static void scaleSourceRow(BitmapT &bitmap, ImageScaler &scaler,
+                           const uint8_t *source) {
+  if (scaler.sourceRow >= scaler.sourceHeight) {
+    return;
+  }
+  const int sourceRow = scaler.sourceRow++;
+  const uint64_t height = scaler.height;
+  const uint64_t sourceHeight = scaler.sourceHeight;
+
+  if (scaler.height >= scaler.sourceHeight) {
+    // Enlarging: repeat this row for every output row sampling it
+    bool resized = false;
+    while (scaler.outputRow < scaler.height &&
+           (2 * (uint64_t)scaler.outputRow + 1) * sourceHeight /
+                   (2 * height) ==
+               (uint64_t)sourceRow) {
+      if (!resized) {
+        scaleColumns(scaler, source);
+        resized = true;
+      }
+      finishRow(bitmap, scaler, scaler.columns, scaler.columnScale);
+    }
+    return;
+  }
+
+  // Shrinking: add this row's share to the output rows it overlaps
+  scaleColumns(scaler, source);
+  uint64_t position = sourceRow * height;
+  const uint64_t end = position + height;
+  while (position < end) {
+    const uint64_t boundary = (scaler.outputRow + 1) * sourceHeight;
+    const uint32_t weight =
+        (uint32_t)((end < boundary ? end : boundary) - position);
+    for (int j = 0; j < scaler.width; j++) {
+      scaler.sums[j] += weight * scaler.columns[j];
+    }
+    position += weight;
+    if (position == boundary) {
+      finishRow(bitmap, scaler, scaler.sums,
+                scaler.columnScale * scaler.sourceHeight);
+      memset(scaler.sums, 0, scaler.width * sizeof(scaler.sums[0]));
+    }
+  }
+}
+
+template <int W, int H>
+void scaleRow(BasicBitmap<W, H> &bitmap, ImageScaler &scaler,
+              const uint8_t *source) {
+  scaleSourceRow(bitmap, scaler, source);
+}
+
+template <int W, int H>
+void scaleRow(PrinterBitmap<W, H> &bitmap, ImageScaler &scaler,
+              const uint8_t *source) {
+  scaleSourceRow(bitmap, scaler, source);
+}
+
+// Shared rather than stack: an ImageScaler is over 4KB
+static ImageScaler imageScaler;
+
+template <typename BitmapT>
+static bool scaleRows(BitmapT &bitmap, const uint8_t *gray, int sourceWidth,
+                      int sourceHeight, int stride, int x, int y, int height,
+                      DitherMethod method) {
+  if (!startImageScaler(imageScaler, sourceWidth, sourceHeight, x, y, height,
+                        method)) {
+    return false;
+  }
+  for (int row = 0; row < sourceHeight; row++) {
+    scaleSourceRow(bitmap, imageScaler, gray + (size_t)row * stride);
+  }
+  return true;
+}
+
+template <int W, int H>
+bool drawScaledImage(BasicBitmap<W, H> &bitmap, const uint8_t *gray,
+                     int sourceWidth, int sourceHeight, int stride, int x,
+                     int y, int height, DitherMethod method) {
+  return scaleRows(bitmap, gray, sourceWidth, sourceHeight, stride, x, y,
+                   height, method);
+}
+
+template <int W, int H>
+bool drawScaledImage(PrinterBitmap<W, H> &bitmap, const uint8_t *gray,
+                     int sourceWidth, int sourceHeight, int stride, int x,
+                     int y, int height, DitherMethod method) {
+  return scaleRows(bitmap, gray, sourceWidth, sourceHeight, stride, x, y,
+                   height, method);
+}
+
+// ============================================================================
+// EXPLICIT INSTANTIATIONS (one per tape canvas)
+// ============================================================================
+
+#define INSTANTIATE_IMAGE_SCALER(W, H)                                         \
+  template void scaleRow(BasicBitmap<W, H> &, ImageScaler &,                   \
+                         const uint8_t *);                                     \
+  template void scaleRow(PrinterBitmap<W, H> &, ImageScaler &,                 \
+                         const uint8_t *);                                     \
+  template bool drawScaledImage(BasicBitmap<W, H> &, const uint8_t *, int,     \
+                                int, int, int, int, int, DitherMethod);        \
+  template bool drawScaledImage(PrinterBitmap<W, H> &, const uint8_t *, int,   \
+                                int, int, int, int, int, DitherMethod);
+
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_IMAGE_SCALER)
+
+#undef INSTANTIATE_IMAGE_SCALER
@@ -0,0 +1,757 @@
+#include <path.h>
+#include <cmath>
+
+// ============================================================================
+// BUILDING
+// ============================================================================
+
+// Curves are split into at most this many lines
+#define MAX_CURVE_SEGMENTS 64
+
+void clearPath(Path &path) {
+  path.pointCount = 0;
+  path.contourCount = 0;
+  path.overflow = false;
+}
+
+// First point of the contour being built
+static int openContourStart(const Path &path) {
+  return path.contourCount ? path.contourEnds[path.contourCount - 1] : 0;
+}
+
+// Finish the contour being built; a lone point is dropped
+static void endContour(Path &path, bool closed) {
+  const int start = openContourStart(path);
+  if (path.pointCount - start < 2) {
+    path.pointCount = start;
+    return;
+  }
+  if (path.contourCount >= MAX_PATH_CONTOURS) {
+    path.pointCount = start;
+    path.overflow = true;
+    return;
+  }
+  path.contourEnds[path.contourCount] = path.pointCount;
+  path.contourClosed[path.contourCount] = closed;
+  path.contourCount++;
+}
+
+// Append to the contour being built, skipping repeats of the last point
+static bool addPoint(Path &path, int32_t x, int32_t y) {
+  if (path.pointCount > openContourStart(path)) {
+    const PathPoint &last = path.points[path.pointCount - 1];
+    if (last.x == x && last.y == y) {
+      return true;
+    }
+  }
+  if (path.pointCount >= MAX_PATH_POINTS) {
+    path.overflow = true;
+    return false;
+  }
+  PathPoint &point = path.points[path.pointCount++];
+  point.x = x;
+  point.y = y;
+  return true;
+}
+
+// The point a new segment starts from, added to the contour being built if
+// that contour is still empty
+static bool currentPoint(Path &path, int32_t x, int32_t y, PathPoint &from) {
+  const int start = openContourStart(path);
+  if (path.pointCount > start) {
+    from = path.points[path.pointCount - 1];
+    return true;
+  }
+  if (path.contourCount > 0 && path.contourClosed[path.contourCount - 1]) {
+    from = path.points[path.contourCount > 1
+                           ? path.contourEnds[path.contourCount - 2]
+                           : 0];
+  } else {
+    from.x = x;
+    from.y = y;
+  }
+  return addPoint(path, from.x, from.y);
+}
+
+bool moveTo(Path &path, int x, int y) {
+  endContour(path, false);
+  return addPoint(path, x * PATH_SUBPIXEL, y * PATH_SUBPIXEL);
+}
+
+bool lineTo(Path &path, int x, int y) {
+  PathPoint from;
+  const int32_t px = x * PATH_SUBPIXEL;
+  const int32_t py = y * PATH_SUBPIXEL;
+  return currentPoint(path, px, py, from) && addPoint(path, px, py);
+}
+
+void closePath(Path &path) { endContour(path, true); }
+
+// Lines needed to keep a Bezier within PATH_FLATNESS of the true curve, from
+// Wang's formula: n^2 >= weight * M / (8 * flatness), M being the largest
+// second difference of the control points
+static int curveSegments(int32_t secondDifference, int weight) {
+  const int32_t limit =
+      (int32_t)((int64_t)weight * secondDifference /
+                    (8 * PATH_FLATNESS) +
+                1);
+  int n = 1;
+  while (n < MAX_CURVE_SEGMENTS && n * n < limit) {
+    n++;
+  }
+  return n;
+}
+
+// Absolute value of a second difference, as |dx| + |dy| (never less than the
+// true length, so never too few segments)
+static int32_t secondDifference(const PathPoint &a, const PathPoint &b,
+                                const PathPoint &c) {
+  const int32_t dx = a.x - 2 * b.x + c.x;
+  const int32_t dy = a.y - 2 * b.y + c.y;
+  return (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+}
+
+// num / den rounded to nearest, den > 0
+static int32_t divRound(int64_t num, int64_t den) {
+  return (int32_t)(num >= 0 ? (num + den / 2) / den
+                            : -((-num + den / 2) / den));
+}
+
+bool quadTo(Path &path, int cx, int cy, int x, int y) {
+  PathPoint p0;
+  const PathPoint p1 = {cx * PATH_SUBPIXEL, cy * PATH_SUBPIXEL};
+  const PathPoint p2 = {x * PATH_SUBPIXEL, y * PATH_SUBPIXEL};
+  if (!currentPoint(path, p1.x, p1.y, p0)) {
+    return false;
+  }
+
+  // Points at t = i / n, in integers scaled by n^2
+  const int n = curveSegments(secondDifference(p0, p1, p2), 2);
+  const int64_t den = (int64_t)n * n;
+  for (int i = 1; i <= n; i++) {
+    const int64_t a = (int64_t)(n - i) * (n - i);
+    const int64_t b = 2 * (int64_t)i * (n - i);
+    const int64_t c = (int64_t)i * i;
+    if (!addPoint(path, divRound(a * p0.x + b * p1.x + c * p2.x, den),
+                  divRound(a * p0.y + b * p1.y + c * p2.y, den))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool cubicTo(Path &path, int c1x, int c1y, int c2x, int c2y, int x, int y) {
+  PathPoint p0;
+  const PathPoint p1 = {c1x * PATH_SUBPIXEL, c1y * PATH_SUBPIXEL};
+  const PathPoint p2 = {c2x * PATH_SUBPIXEL, c2y * PATH_SUBPIXEL};
+  const PathPoint p3 = {x * PATH_SUBPIXEL, y * PATH_SUBPIXEL};
+  if (!currentPoint(path, p1.x, p1.y, p0)) {
+    return false;
+  }
+
+  const int32_t d1 = secondDifference(p0, p1, p2);
+  const int32_t d2 = secondDifference(p1, p2, p3);
+  const int n = curveSegments(d1 > d2 ? d1 : d2, 6);
+  const int64_t den = (int64_t)n * n * n;
+  for (int i = 1; i <= n; i++) {
+    const int64_t s = n - i;
+    const int64_t a = s * s * s;
+    const int64_t b = 3 * s * s * i;
+    const int64_t c = 3 * s * i * i;
+    const int64_t d = (int64_t)i * i * i;
+    if (!addPoint(path,
+                  divRound(a * p0.x + b * p1.x + c * p2.x + d * p3.x, den),
+                  divRound(a * p0.y + b * p1.y + c * p2.y + d * p3.y, den))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ============================================================================
+// SCANLINE FILL
+// Edges go into a table sorted by their first scanline. The active edge
+// table holds the edges crossing the current scanline in x order, so each
+// scanline costs time in its edges and spans, not its width.
+// ============================================================================
+
+struct PathEdge {
+  int32_t x;    // crossing of the current scanline, 16.16 pixels
+  int32_t step; // change of x per scanline
+  int y1;       // first scanline crossed
+  int y2;       // one past the last
+  int winding;  // +1 going down, -1 going up
+};
+
+// Shared scratch rather than stack: a full path has MAX_PATH_POINTS edges
+static PathEdge edgeTable[MAX_PATH_POINTS];
+static PathEdge *activeEdges[MAX_PATH_POINTS];
+
+static inline int32_t floorDiv(int32_t a, int32_t b) {
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// Scanline y samples pixel centres at y + 1/2: the first scanline whose
+// centre is at or below subpixel row sy
+static inline int scanlineFrom(int32_t sy) {
+  return floorDiv(sy - PATH_SUBPIXEL / 2 + PATH_SUBPIXEL - 1, PATH_SUBPIXEL);
+}
+
+// First pixel whose centre is at or right of a 16.16 x
+static inline int pixelFrom(int32_t x) { return floorDiv(x + 0x7FFF, 0x10000); }
+
+// Add the edge a-b, limited to scanlines [clipY1, clipY2), keeping the table
+// sorted by first scanline
+static void addEdge(const PathPoint &a, const PathPoint &b, int clipY1,
+                    int clipY2, int &count) {
+  if (a.y == b.y) {
+    return;
+  }
+  const bool down = a.y < b.y;
+  const PathPoint &top = down ? a : b;
+  const PathPoint &bottom = down ? b : a;
+  int y1 = scanlineFrom(top.y);
+  int y2 = scanlineFrom(bottom.y);
+  if (y1 < clipY1)
+    y1 = clipY1;
+  if (y2 > clipY2)
+    y2 = clipY2;
+  if (y1 >= y2) {
+    return;
+  }
+
+  PathEdge edge;
+  const int64_t dx = bottom.x - top.x;
+  const int64_t dy = bottom.y - top.y;
+  const int64_t sy = (int64_t)y1 * PATH_SUBPIXEL + PATH_SUBPIXEL / 2;
+  edge.x = (int32_t)(((int64_t)top.x * dy + (sy - top.y) * dx) *
+                     (0x10000 / PATH_SUBPIXEL) / dy);
+  edge.step = (int32_t)(dx * 0x10000 / dy);
+  edge.y1 = y1;
+  edge.y2 = y2;
+  edge.winding = down ? 1 : -1;
+
+  int i = count++;
+  while (i > 0 && edgeTable[i - 1].y1 > y1) {
+    edgeTable[i] = edgeTable[i - 1];
+    i--;
+  }
+  edgeTable[i] = edge;
+}
+
+// Every contour, closed or not, from its last point back to its first
+static int buildEdges(const Path &path, int clipY1, int clipY2) {
+  int count = 0;
+  int start = 0;
+  for (int c = 0; c <= path.contourCount; c++) {
+    const int end =
+        c < path.contourCount ? path.contourEnds[c] : path.pointCount;
+    for (int i = start; i < end; i++) {
+      const PathPoint &b = path.points[i + 1 < end ? i + 1 : start];
+      addEdge(path.points[i], b, clipY1, clipY2, count);
+    }
+    start = end;
+  }
+  return count;
+}
+
+// Hand span(y, x1, x2) every inside run [x1, x2) of scanlines [y1, y2), one
+// call per run: touching or overlapping pieces are merged first
+template <typename Span>
+static void scanPath(const Path &path, FillRule rule, int y1, int y2,
+                     Span span) {
+  const int count = buildEdges(path, y1, y2);
+  int next = 0;
+  int activeCount = 0;
+  int y = count ? edgeTable[0].y1 : 0;
+
+  while (next < count || activeCount > 0) {
+    if (activeCount == 0 && edgeTable[next].y1 > y) {
+      y = edgeTable[next].y1;
+    }
+    while (next < count && edgeTable[next].y1 == y) {
+      PathEdge *edge = &edgeTable[next++];
+      int i = activeCount++;
+      while (i > 0 && activeEdges[i - 1]->x > edge->x) {
+        activeEdges[i] = activeEdges[i - 1];
+        i--;
+      }
+      activeEdges[i] = edge;
+    }
+
+    int winding = 0;
+    int runStart = 0;
+    int runEnd = 0;
+    bool pending = false;
+    for (int i = 0; i + 1 < activeCount; i++) {
+      winding += rule == FILL_EVEN_ODD ? 1 : activeEdges[i]->winding;
+      const bool inside = rule == FILL_EVEN_ODD ? (winding & 1) : winding;
+      if (!inside) {
+        continue;
+      }
+      const int x1 = pixelFrom(activeEdges[i]->x);
+      const int x2 = pixelFrom(activeEdges[i + 1]->x);
+      if (x1 >= x2) {
+        continue;
+      }
+      if (pending && x1 <= runEnd) {
+        if (x2 > runEnd)
+          runEnd = x2;
+        continue;
+      }
+      if (pending) {
+        span(y, runStart, runEnd);
+      }
+      runStart = x1;
+      runEnd = x2;
+      pending = true;
+    }
+    if (pending) {
+      span(y, runStart, runEnd);
+    }
+
+    // Step to the next scanline, dropping finished edges. Edges rarely
+    // cross, so the insertion sort is usually one compare per edge.
+    y++;
+    int kept = 0;
+    for (int i = 0; i < activeCount; i++) {
+      PathEdge *edge = activeEdges[i];
+      if (edge->y2 <= y) {
+        continue;
+      }
+      edge->x += edge->step;
+      int j = kept++;
+      while (j > 0 && activeEdges[j - 1]->x > edge->x) {
+        activeEdges[j] = activeEdges[j - 1];
+        j--;
+      }
+      activeEdges[j] = edge;
+    }
+    activeCount = kept;
+  }
+}
+
+template <int W, int H>
+void fillPath(BasicBitmap<W, H> &bitmap, const Path &path, FillRule rule) {
+  scanPath(path, rule, bitmap.clip.rect.y1, bitmap.clip.rect.y2,
+           [&bitmap](int y, int x1, int x2) {
+             fillSpan(bitmap, y, x1, x2, true);
+           });
+}
+
+template <int W, int H>
+void fillPath(PrinterBitmap<W, H> &bitmap, const Path &path, FillRule rule) {
+  scanPath(path, rule, bitmap.clip.rect.y1, bitmap.clip.rect.y2,
+           [&bitmap](int y, int x1, int x2) {
+             fillSpan(bitmap, y, x1, x2, true);
+           });
+}
+
+// ============================================================================
+// STROKES
+// Geometry is worked out in float subpixels (the ESP32 has a single-precision
+// FPU) and rounded when polygons are stored. Every polygon is wound the same
+// way, which is what lets the non-zero fill merge them.
+// ============================================================================
+
+struct StrokePoint {
+  float x;
+  float y;
+};
+
+// Polygons of the stroke being drawn; filled whenever it runs out of room
+static Path strokeScratch;
+
+#define MAX_DISC_POINTS 64
+
+static inline StrokePoint strokePoint(float x, float y) {
+  StrokePoint p = {x, y};
+  return p;
+}
+
+// Store a polygon in path, reversed if needed so its shoelace area is
+// negative (the winding of a quad built by Stroker::segment)
+static void addPolygon(Path &path, const StrokePoint *points, int count) {
+  float area = 0;
+  for (int i = 0; i < count; i++) {
+    const StrokePoint &a = points[i];
+    const StrokePoint &b = points[i + 1 < count ? i + 1 : 0];
+    area += a.x * b.y - b.x * a.y;
+  }
+  if (area == 0) {
+    return;
+  }
+  for (int i = 0; i < count; i++) {
+    const StrokePoint &p = points[area < 0 ? i : count - 1 - i];
+    PathPoint &out = path.points[path.pointCount++];
+    out.x = lroundf(p.x);
+    out.y = lroundf(p.y);
+  }
+  path.contourEnds[path.contourCount] = path.pointCount;
+  path.contourClosed[path.contourCount] = true;
+  path.contourCount++;
+}
+
+template <typename BitmapT> struct Stroker {
+  BitmapT &bitmap;
+  const StrokeStyle &style;
+  float halfWidth; // subpixels
+
+  // Dash state: pattern entry, its length left, and whether it is drawn
+  int dashCount;
+  int dashIndex;
+  float dashLeft;
+
+  Stroker(BitmapT &bitmap, const StrokeStyle &style)
+      : bitmap(bitmap), style(style),
+        halfWidth(style.width * PATH_SUBPIXEL * 0.5f), dashCount(0),
+        dashIndex(0), dashLeft(0) {
+    clearPath(strokeScratch);
+  }
+
+  void flush() {
+    fillPath(bitmap, strokeScratch, FILL_NON_ZERO);
+    clearPath(strokeScratch);
+  }
+
+  void polygon(const StrokePoint *points, int count) {
+    if (strokeScratch.pointCount + count > MAX_PATH_POINTS ||
+        strokeScratch.contourCount >= MAX_PATH_CONTOURS) {
+      flush();
+    }
+    addPolygon(strokeScratch, points, count);
+  }
+
+  // Normal of a unit direction, scaled to half the width
+  StrokePoint normal(const StrokePoint &dir) const {
+    return strokePoint(-dir.y * halfWidth, dir.x * halfWidth);
+  }
+
+  void segment(const StrokePoint &a, const StrokePoint &b,
+               const StrokePoint &dir) {
+    const StrokePoint n = normal(dir);
+    const StrokePoint quad[4] = {
+        strokePoint(a.x + n.x, a.y + n.y),
+        strokePoint(b.x + n.x, b.y + n.y),
+        strokePoint(b.x - n.x, b.y - n.y),
+        strokePoint(a.x - n.x, a.y - n.y),
+    };
+    polygon(quad, 4);
+  }
+
+  // Enough sides to stay within PATH_FLATNESS of the circle
+  void disc(const StrokePoint &p) {
+    int sides = (int)ceilf(3.14159265f *
+                           sqrtf(halfWidth / (2.0f * PATH_FLATNESS)));
+    if (sides < 8)
+      sides = 8;
+    if (sides > MAX_DISC_POINTS)
+      sides = MAX_DISC_POINTS;
+    StrokePoint points[MAX_DISC_POINTS];
+    for (int i = 0; i < sides; i++) {
+      const float angle = 2.0f * 3.14159265f * i / sides;
+      points[i] = strokePoint(p.x + halfWidth * cosf(angle),
+                              p.y + halfWidth * sinf(angle));
+    }
+    polygon(points, sides);
+  }
+
+  // Cap at p; dir points away from the stroke
+  void cap(const StrokePoint &p, const StrokePoint &dir) {
+    if (style.cap == CAP_ROUND) {
+      disc(p);
+    } else if (style.cap == CAP_SQUARE) {
+      const StrokePoint n = normal(dir);
+      const StrokePoint d = strokePoint(dir.x * halfWidth, dir.y * halfWidth);
+      const StrokePoint square[4] = {
+          strokePoint(p.x + n.x, p.y + n.y),
+          strokePoint(p.x + n.x + d.x, p.y + n.y + d.y),
+          strokePoint(p.x - n.x + d.x, p.y - n.y + d.y),
+          strokePoint(p.x - n.x, p.y - n.y),
+      };
+      polygon(square, 4);
+    }
+  }
+
+  // Fill the wedge on the outside of the turn at p; the segment quads
+  // already overlap on the inside
+  void join(const StrokePoint &p, const StrokePoint &in,
+            const StrokePoint &out) {
+    const float cross = in.x * out.y - in.y * out.x;
+    const float dot = in.x * out.x + in.y * out.y;
+    if (fabsf(cross) < 1e-4f && dot > 0) {
+      return;
+    }
+    if (style.join == JOIN_ROUND) {
+      disc(p);
+      return;
+    }
+
+    const float side = cross > 0 ? -1.0f : 1.0f;
+    const StrokePoint nIn = normal(in);
+    const StrokePoint nOut = normal(out);
+    const StrokePoint a = strokePoint(p.x + side * nIn.x, p.y + side * nIn.y);
+    const StrokePoint b =
+        strokePoint(p.x + side * nOut.x, p.y + side * nOut.y);
+
+    // Unit normals summed: length 2 cos(theta / 2), and the miter reaches
+    // halfWidth / cos(theta / 2) from p along that sum
+    const float mx = (nIn.x + nOut.x) / halfWidth;
+    const float my = (nIn.y + nOut.y) / halfWidth;
+    const float length2 = mx * mx + my * my;
+    if (style.join == JOIN_MITER && length2 > 0 &&
+        4.0f / length2 <= STROKE_MITER_LIMIT * STROKE_MITER_LIMIT) {
+      const float reach = side * 2.0f * halfWidth / length2;
+      const StrokePoint miter[4] = {
+          p, a, strokePoint(p.x + mx * reach, p.y + my * reach), b};
+      polygon(miter, 4);
+      return;
+    }
+    const StrokePoint bevel[3] = {p, a, b};
+    polygon(bevel, 3);
+  }
+
+  bool dashed() const { return dashCount > 0; }
+  bool dashOn() const { return (dashIndex & 1) == 0; }
+
+  void nextDash() {
+    dashIndex = (dashIndex + 1) % dashCount;
+    dashLeft = style.dashes[dashIndex % style.dashCount] * PATH_SUBPIXEL;
+  }
+
+  // Restart the pattern at dashOffset (each contour starts afresh)
+  void startDashes() {
+    dashCount = 0;
+    if (style.dashCount <= 0 || style.dashCount > MAX_DASHES) {
+      return;
+    }
+    int total = 0;
+    for (int i = 0; i < style.dashCount; i++) {
+      if (style.dashes[i] < 0) {
+        return;
+      }
+      total += style.dashes[i];
+    }
+    if (total == 0) {
+      return;
+    }
+    // An odd pattern runs twice so on and off alternate
+    dashCount = style.dashCount * (style.dashCount & 1 ? 2 : 1);
+    total *= dashCount / style.dashCount;
+
+    int offset = style.dashOffset % total;
+    if (offset < 0)
+      offset += total;
+    dashIndex = 0;
+    dashLeft = style.dashes[0] * PATH_SUBPIXEL;
+    float skip = offset * PATH_SUBPIXEL;
+    while (skip > dashLeft) {
+      skip -= dashLeft;
+      nextDash();
+    }
+    dashLeft -= skip;
+  }
+
+  // Stroke points[0, count), given in subpixels relative to pixel corners
+  void contour(const PathPoint *points, int count, bool closed) {
+    StrokePoint first = strokePoint(points[0].x + PATH_SUBPIXEL / 2,
+                                    points[0].y + PATH_SUBPIXEL / 2);
+    const int segments = closed ? count : count - 1;
+    startDashes();
+
+    bool inPiece = false;
+    bool deferredCap = false; // the first dash of a closed contour may join
+    bool started = false;
+    StrokePoint firstDir = {0, 0};
+    StrokePoint lastDir = {0, 0};
+    StrokePoint end = first;
+
+    for (int s = 0; s < segments; s++) {
+      const PathPoint &pa = points[s];
+      const PathPoint &pb = points[s + 1 < count ? s + 1 : 0];
+      const StrokePoint a = strokePoint(pa.x + PATH_SUBPIXEL / 2,
+                                        pa.y + PATH_SUBPIXEL / 2);
+      const StrokePoint b = strokePoint(pb.x + PATH_SUBPIXEL / 2,
+                                        pb.y + PATH_SUBPIXEL / 2);
+      const float length = hypotf(b.x - a.x, b.y - a.y);
+      if (length == 0) {
+        continue;
+      }
+      const StrokePoint dir =
+          strokePoint((b.x - a.x) / length, (b.y - a.y) / length);
+      const StrokePoint back = strokePoint(-dir.x, -dir.y);
+      if (!started) {
+        firstDir = dir;
+        started = true;
+      }
+      end = b;
+
+      if (!dashed()) {
+        if (inPiece) {
+          join(a, lastDir, dir);
+        } else {
+          inPiece = true;
+          if (!closed)
+            cap(a, back);
+        }
+        segment(a, b, dir);
+        lastDir = dir;
+        continue;
+      }
+
+      for (float t = 0;;) {
+        const float remaining = length - t;
+        const bool dashEnds = dashLeft <= remaining;
+        const float step = dashEnds ? dashLeft : remaining;
+        const StrokePoint p = strokePoint(a.x + dir.x * t, a.y + dir.y * t);
+        const StrokePoint q =
+            dashEnds ? strokePoint(a.x + dir.x * (t + step),
+                                   a.y + dir.y * (t + step))
+                     : b;
+        if (dashOn()) {
+          if (!inPiece) {
+            inPiece = true;
+            if (closed && s == 0 && t == 0) {
+              deferredCap = true;
+            } else {
+              cap(p, back);
+            }
+          } else if (t == 0) {
+            join(a, lastDir, dir);
+          }
+          if (step > 0) {
+            segment(p, q, dir);
+          }
+          lastDir = dir;
+        }
+        if (!dashEnds) {
+          dashLeft -= remaining;
+          break;
+        }
+        t += step;
+        if (dashOn() && inPiece) {
+          cap(q, dir);
+          inPiece = false;
+        }
+        nextDash();
+      }
+    }
+
+    if (!started) {
+      // Zero length: square and round caps still leave a mark
+      cap(first, strokePoint(1, 0));
+      cap(first, strokePoint(-1, 0));
+      return;
+    }
+    if (closed && inPiece && (!dashed() || deferredCap)) {
+      join(first, lastDir, firstDir);
+      return;
+    }
+    if (inPiece) {
+      cap(end, lastDir);
+    }
+    if (deferredCap) {
+      cap(first, strokePoint(-firstDir.x, -firstDir.y));
+    }
+  }
+};
+
+template <typename BitmapT>
+static void strokeContours(BitmapT &bitmap, const Path &path,
+                           const StrokeStyle &style) {
+  if (style.width <= 0) {
+    return;
+  }
+  Stroker<BitmapT> stroker(bitmap, style);
+  int start = 0;
+  for (int c = 0; c <= path.contourCount; c++) {
+    const bool finished = c < path.contourCount;
+    const int end = finished ? path.contourEnds[c] : path.pointCount;
+    if (end > start) {
+      stroker.contour(path.points + start, end - start,
+                      finished && path.contourClosed[c]);
+    }
+    start = end;
+  }
+  stroker.flush();
+}
+
+template <typename BitmapT>
+static void strokePoints(BitmapT &bitmap, const int *coordinates, int count,
+                         bool closed, const StrokeStyle &style) {
+  if (style.width <= 0) {
+    return;
+  }
+  PathPoint points[4];
+  for (int i = 0; i < count; i++) {
+    points[i].x = coordinates[2 * i] * PATH_SUBPIXEL;
+    points[i].y = coordinates[2 * i + 1] * PATH_SUBPIXEL;
+  }
+  Stroker<BitmapT> stroker(bitmap, style);
+  stroker.contour(points, count, closed);
+  stroker.flush();
+}
+
+template <int W, int H>
+void strokePath(BasicBitmap<W, H> &bitmap, const Path &path,
+                const StrokeStyle &style) {
+  strokeContours(bitmap, path, style);
+}
+
+template <int W, int H>
+void strokePath(PrinterBitmap<W, H> &bitmap, const Path &path,
+                const StrokeStyle &style) {
+  strokeContours(bitmap, path, style);
+}
+
+template <int W, int H>
+void drawThickLine(BasicBitmap<W, H> &bitmap, int x0, int y0, int x1, int y1,
+                   const StrokeStyle &style) {
+  const int coordinates[] = {x0, y0, x1, y1};
+  strokePoints(bitmap, coordinates, 2, false, style);
+}
+
+template <int W, int H>
+void drawThickLine(PrinterBitmap<W, H> &bitmap, int x0, int y0, int x1,
+                   int y1, const StrokeStyle &style) {
+  const int coordinates[] = {x0, y0, x1, y1};
+  strokePoints(bitmap, coordinates, 2, false, style);
+}
+
+template <int W, int H>
+void drawThickRect(BasicBitmap<W, H> &bitmap, int x1, int y1, int x2, int y2,
+                   const StrokeStyle &style) {
+  const int coordinates[] = {x1, y1, x2, y1, x2, y2, x1, y2};
+  strokePoints(bitmap, coordinates, 4, true, style);
+}
+
+template <int W, int H>
+void drawThickRect(PrinterBitmap<W, H> &bitmap, int x1, int y1, int x2,
+                   int y2, const StrokeStyle &style) {
+  const int coordinates[] = {x1, y1, x2, y1, x2, y2, x1, y2};
+  strokePoints(bitmap, coordinates, 4, true, style);
+}
+
+// ============================================================================
+// EXPLICIT INSTANTIATIONS (one per tape canvas)
+// ============================================================================
+
+#define INSTANTIATE_PATH(W, H)                                                 \
+  template void fillPath(BasicBitmap<W, H> &, const Path &, FillRule);         \
+  template void fillPath(PrinterBitmap<W, H> &, const Path &, FillRule);       \
+  template void strokePath(BasicBitmap<W, H> &, const Path &,                  \
+                           const StrokeStyle &);                               \
+  template void strokePath(PrinterBitmap<W, H> &, const Path &,                \
+                           const StrokeStyle &);                               \
+  template void drawThickLine(BasicBitmap<W, H> &, int, int, int, int,         \
+                              const StrokeStyle &);                            \
+  template void drawThickLine(PrinterBitmap<W, H> &, int, int, int, int,       \
+                              const StrokeStyle &);                            \
+  template void drawThickRect(BasicBitmap<W, H> &, int, int, int, int,         \
+                              const StrokeStyle &);                            \
+  template void drawThickRect(PrinterBitmap<W, H> &, int, int, int, int,       \
+                              const StrokeStyle &);
+
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_PATH)
+
+#undef INSTANTIATE_PATH
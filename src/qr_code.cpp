@@ -0,0 +1,789 @@
+#include <qr_code.h>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+// ============================================================================
+// GF(256)
+// ============================================================================
+
+// Powers of 2 modulo x^8 + x^4 + x^3 + x^2 + 1, repeated once so the sum of
+// two logarithms indexes it without a modulo
+static const uint8_t GF_EXP[510] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1D, 0x3A, 0x74, 0xE8,
+    0xCD, 0x87, 0x13, 0x26, 0x4C, 0x98, 0x2D, 0x5A, 0xB4, 0x75, 0xEA, 0xC9,
+    0x8F, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0x9D, 0x27, 0x4E, 0x9C,
+    0x25, 0x4A, 0x94, 0x35, 0x6A, 0xD4, 0xB5, 0x77, 0xEE, 0xC1, 0x9F, 0x23,
+    0x46, 0x8C, 0x05, 0x0A, 0x14, 0x28, 0x50, 0xA0, 0x5D, 0xBA, 0x69, 0xD2,
+    0xB9, 0x6F, 0xDE, 0xA1, 0x5F, 0xBE, 0x61, 0xC2, 0x99, 0x2F, 0x5E, 0xBC,
+    0x65, 0xCA, 0x89, 0x0F, 0x1E, 0x3C, 0x78, 0xF0, 0xFD, 0xE7, 0xD3, 0xBB,
+    0x6B, 0xD6, 0xB1, 0x7F, 0xFE, 0xE1, 0xDF, 0xA3, 0x5B, 0xB6, 0x71, 0xE2,
+    0xD9, 0xAF, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0D, 0x1A, 0x34, 0x68,
+    0xD0, 0xBD, 0x67, 0xCE, 0x81, 0x1F, 0x3E, 0x7C, 0xF8, 0xED, 0xC7, 0x93,
+    0x3B, 0x76, 0xEC, 0xC5, 0x97, 0x33, 0x66, 0xCC, 0x85, 0x17, 0x2E, 0x5C,
+    0xB8, 0x6D, 0xDA, 0xA9, 0x4F, 0x9E, 0x21, 0x42, 0x84, 0x15, 0x2A, 0x54,
+    0xA8, 0x4D, 0x9A, 0x29, 0x52, 0xA4, 0x55, 0xAA, 0x49, 0x92, 0x39, 0x72,
+    0xE4, 0xD5, 0xB7, 0x73, 0xE6, 0xD1, 0xBF, 0x63, 0xC6, 0x91, 0x3F, 0x7E,
+    0xFC, 0xE5, 0xD7, 0xB3, 0x7B, 0xF6, 0xF1, 0xFF, 0xE3, 0xDB, 0xAB, 0x4B,
+    0x96, 0x31, 0x62, 0xC4, 0x95, 0x37, 0x6E, 0xDC, 0xA5, 0x57, 0xAE, 0x41,
+    0x82, 0x19, 0x32, 0x64, 0xC8, 0x8D, 0x07, 0x0E, 0x1C, 0x38, 0x70, 0xE0,
+    0xDD, 0xA7, 0x53, 0xA6, 0x51, 0xA2, 0x59, 0xB2, 0x79, 0xF2, 0xF9, 0xEF,
+    0xC3, 0x9B, 0x2B, 0x56, 0xAC, 0x45, 0x8A, 0x09, 0x12, 0x24, 0x48, 0x90,
+    0x3D, 0x7A, 0xF4, 0xF5, 0xF7, 0xF3, 0xFB, 0xEB, 0xCB, 0x8B, 0x0B, 0x16,
+    0x2C, 0x58, 0xB0, 0x7D, 0xFA, 0xE9, 0xCF, 0x83, 0x1B, 0x36, 0x6C, 0xD8,
+    0xAD, 0x47, 0x8E, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1D,
+    0x3A, 0x74, 0xE8, 0xCD, 0x87, 0x13, 0x26, 0x4C, 0x98, 0x2D, 0x5A, 0xB4,
+    0x75, 0xEA, 0xC9, 0x8F, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0x9D,
+    0x27, 0x4E, 0x9C, 0x25, 0x4A, 0x94, 0x35, 0x6A, 0xD4, 0xB5, 0x77, 0xEE,
+    0xC1, 0x9F, 0x23, 0x46, 0x8C, 0x05, 0x0A, 0x14, 0x28, 0x50, 0xA0, 0x5D,
+    0xBA, 0x69, 0xD2, 0xB9, 0x6F, 0xDE, 0xA1, 0x5F, 0xBE, 0x61, 0xC2, 0x99,
+    0x2F, 0x5E, 0xBC, 0x65, 0xCA, 0x89, 0x0F, 0x1E, 0x3C, 0x78, 0xF0, 0xFD,
+    0xE7, 0xD3, 0xBB, 0x6B, 0xD6, 0xB1, 0x7F, 0xFE, 0xE1, 0xDF, 0xA3, 0x5B,
+    0xB6, 0x71, 0xE2, 0xD9, 0xAF, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0D,
+    0x1A, 0x34, 0x68, 0xD0, 0xBD, 0x67, 0xCE, 0x81, 0x1F, 0x3E, 0x7C, 0xF8,
+    0xED, 0xC7, 0x93, 0x3B, 0x76, 0xEC, 0xC5, 0x97, 0x33, 0x66, 0xCC, 0x85,
+    0x17, 0x2E, 0x5C, 0xB8, 0x6D, 0xDA, 0xA9, 0x4F, 0x9E, 0x21, 0x42, 0x84,
+    0x15, 0x2A, 0x54, 0xA8, 0x4D, 0x9A, 0x29, 0x52, 0xA4, 0x55, 0xAA, 0x49,
+    0x92, 0x39, 0x72, 0xE4, 0xD5, 0xB7, 0x73, 0xE6, 0xD1, 0xBF, 0x63, 0xC6,
+    0x91, 0x3F, 0x7E, 0xFC, 0xE5, 0xD7, 0xB3, 0x7B, 0xF6, 0xF1, 0xFF, 0xE3,
+    0xDB, 0xAB, 0x4B, 0x96, 0x31, 0x62, 0xC4, 0x95, 0x37, 0x6E, 0xDC, 0xA5,
+    0x57, 0xAE, 0x41, 0x82, 0x19, 0x32, 0x64, 0xC8, 0x8D, 0x07, 0x0E, 0x1C,
+    0x38, 0x70, 0xE0, 0xDD, 0xA7, 0x53, 0xA6, 0x51, 0xA2, 0x59, 0xB2, 0x79,
+    0xF2, 0xF9, 0xEF, 0xC3, 0x9B, 0x2B, 0x56, 0xAC, 0x45, 0x8A, 0x09, 0x12,
+    0x24, 0x48, 0x90, 0x3D, 0x7A, 0xF4, 0xF5, 0xF7, 0xF3, 0xFB, 0xEB, 0xCB,
+    0x8B, 0x0B, 0x16, 0x2C, 0x58, 0xB0, 0x7D, 0xFA, 0xE9, 0xCF, 0x83, 0x1B,
+    0x36, 0x6C, 0xD8, 0xAD, 0x47, 0x8E,
+};
+
+// Discrete logarithms base 2 (GF_LOG[0] is unused)
+static const uint8_t GF_LOG[256] = {
+    0x00, 0x00, 0x01, 0x19, 0x02, 0x32, 0x1A, 0xC6, 0x03, 0xDF, 0x33, 0xEE,
+    0x1B, 0x68, 0xC7, 0x4B, 0x04, 0x64, 0xE0, 0x0E, 0x34, 0x8D, 0xEF, 0x81,
+    0x1C, 0xC1, 0x69, 0xF8, 0xC8, 0x08, 0x4C, 0x71, 0x05, 0x8A, 0x65, 0x2F,
+    0xE1, 0x24, 0x0F, 0x21, 0x35, 0x93, 0x8E, 0xDA, 0xF0, 0x12, 0x82, 0x45,
+    0x1D, 0xB5, 0xC2, 0x7D, 0x6A, 0x27, 0xF9, 0xB9, 0xC9, 0x9A, 0x09, 0x78,
+    0x4D, 0xE4, 0x72, 0xA6, 0x06, 0xBF, 0x8B, 0x62, 0x66, 0xDD, 0x30, 0xFD,
+    0xE2, 0x98, 0x25, 0xB3, 0x10, 0x91, 0x22, 0x88, 0x36, 0xD0, 0x94, 0xCE,
+    0x8F, 0x96, 0xDB, 0xBD, 0xF1, 0xD2, 0x13, 0x5C, 0x83, 0x38, 0x46, 0x40,
+    0x1E, 0x42, 0xB6, 0xA3, 0xC3, 0x48, 0x7E, 0x6E, 0x6B, 0x3A, 0x28, 0x54,
+    0xFA, 0x85, 0xBA, 0x3D, 0xCA, 0x5E, 0x9B, 0x9F, 0x0A, 0x15, 0x79, 0x2B,
+    0x4E, 0xD4, 0xE5, 0xAC, 0x73, 0xF3, 0xA7, 0x57, 0x07, 0x70, 0xC0, 0xF7,
+    0x8C, 0x80, 0x63, 0x0D, 0x67, 0x4A, 0xDE, 0xED, 0x31, 0xC5, 0xFE, 0x18,
+    0xE3, 0xA5, 0x99, 0x77, 0x26, 0xB8, 0xB4, 0x7C, 0x11, 0x44, 0x92, 0xD9,
+    0x23, 0x20, 0x89, 0x2E, 0x37, 0x3F, 0xD1, 0x5B, 0x95, 0xBC, 0xCF, 0xCD,
+    0x90, 0x87, 0x97, 0xB2, 0xDC, 0xFC, 0xBE, 0x61, 0xF2, 0x56, 0xD3, 0xAB,
+    0x14, 0x2A, 0x5D, 0x9E, 0x84, 0x3C, 0x39, 0x53, 0x47, 0x6D, 0x41, 0xA2,
+    0x1F, 0x2D, 0x43, 0xD8, 0xB7, 0x7B, 0xA4, 0x76, 0xC4, 0x17, 0x49, 0xEC,
+    0x7F, 0x0C, 0x6F, 0xF6, 0x6C, 0xA1, 0x3B, 0x52, 0x29, 0x9D, 0x55, 0xAA,
+    0xFB, 0x60, 0x86, 0xB1, 0xBB, 0xCC, 0x3E, 0x5A, 0xCB, 0x59, 0x5F, 0xB0,
+    0x9C, 0xA9, 0xA0, 0x51, 0x0B, 0xF5, 0x16, 0xEB, 0x7A, 0x75, 0x2C, 0xD7,
+    0x4F, 0xAE, 0xD5, 0xE9, 0xE6, 0xE7, 0xAD, 0xE8, 0x74, 0xD6, 0xF4, 0xEA,
+    0xA8, 0x50, 0x58, 0xAF,
+};
+
+static inline uint8_t gfMul(uint8_t a, uint8_t b) {
+  return a && b ? GF_EXP[GF_LOG[a] + GF_LOG[b]] : 0;
+}
+
+// ============================================================================
+// REED-SOLOMON
+// ============================================================================
+
+#define QR_MAX_ECC_CODEWORDS 30
+#define QR_MAX_BLOCKS 4
+
+// Generator polynomial of the given degree, highest coefficient first with
+// the leading 1 left out
+static void rsGenerator(uint8_t *generator, int degree) {
+  memset(generator, 0, degree);
+  generator[degree - 1] = 1;
+  uint8_t root = 1;
+  for (int i = 0; i < degree; i++) {
+    // Multiply by (x - 2^i)
+    for (int j = 0; j < degree; j++) {
+      generator[j] = gfMul(generator[j], root);
+      if (j + 1 < degree) {
+        generator[j] ^= generator[j + 1];
+      }
+    }
+    root = gfMul(root, 0x02);
+  }
+}
+
+// ECC codewords of a block: the remainder of data(x) * x^degree divided by
+// the generator
+static void rsRemainder(const uint8_t *data, int length,
+                        const uint8_t *generator, int degree,
+                        uint8_t *remainder) {
+  memset(remainder, 0, degree);
+  for (int i = 0; i < length; i++) {
+    const uint8_t factor = data[i] ^ remainder[0];
+    memmove(remainder, remainder + 1, degree - 1);
+    remainder[degree - 1] = 0;
+    if (!factor) {
+      continue;
+    }
+    const int logFactor = GF_LOG[factor];
+    for (int j = 0; j < degree; j++) {
+      if (generator[j]) {
+        remainder[j] ^= GF_EXP[GF_LOG[generator[j]] + logFactor];
+      }
+    }
+  }
+}
+
+// ============================================================================
+// VERSION TABLES (indexed by version; 0 is unused)
+// ============================================================================
+
+#define QR_MAX_CODEWORDS 172
+#define QR_MAX_DATA_CODEWORDS 136
+
+static const uint8_t QR_TOTAL_CODEWORDS[QR_MAX_VERSION + 1] = {
+    0, 26, 44, 70, 100, 134, 172,
+};
+
+static const uint8_t QR_ECC_PER_BLOCK[4][QR_MAX_VERSION + 1] = {
+    {0, 7, 10, 15, 20, 26, 18},
+    {0, 10, 16, 26, 18, 24, 16},
+    {0, 13, 22, 18, 26, 18, 24},
+    {0, 17, 28, 22, 16, 22, 28},
+};
+
+static const uint8_t QR_BLOCKS[4][QR_MAX_VERSION + 1] = {
+    {0, 1, 1, 1, 1, 1, 2},
+    {0, 1, 1, 1, 2, 2, 4},
+    {0, 1, 1, 2, 2, 4, 4},
+    {0, 1, 1, 2, 4, 4, 4},
+};
+
+// Level field of the format information
+static const uint8_t QR_ECC_FORMAT[4] = {1, 0, 3, 2};
+
+static int dataCodewords(int version, QrEcc ecc) {
+  return QR_TOTAL_CODEWORDS[version] -
+         QR_BLOCKS[ecc][version] * QR_ECC_PER_BLOCK[ecc][version];
+}
+
+// Split data into blocks, compute each block's ECC and interleave the lot
+// into the final codeword sequence
+static void addEccAndInterleave(const uint8_t *data, int version, QrEcc ecc,
+                                uint8_t *out) {
+  const int blocks = QR_BLOCKS[ecc][version];
+  const int eccLength = QR_ECC_PER_BLOCK[ecc][version];
+  const int total = QR_TOTAL_CODEWORDS[version];
+  // With an uneven split the last blocks carry one more data codeword
+  const int shortBlocks = blocks - total % blocks;
+  const int shortLength = total / blocks - eccLength;
+
+  uint8_t generator[QR_MAX_ECC_CODEWORDS];
+  rsGenerator(generator, eccLength);
+
+  uint8_t eccBlocks[QR_MAX_BLOCKS][QR_MAX_ECC_CODEWORDS];
+  int start[QR_MAX_BLOCKS];
+  int offset = 0;
+  for (int b = 0; b < blocks; b++) {
+    const int length = shortLength + (b >= shortBlocks ? 1 : 0);
+    start[b] = offset;
+    rsRemainder(data + offset, length, generator, eccLength, eccBlocks[b]);
+    offset += length;
+  }
+
+  int k = 0;
+  for (int i = 0; i <= shortLength; i++) {
+    for (int b = 0; b < blocks; b++) {
+      if (i < shortLength || b >= shortBlocks) {
+        out[k++] = data[start[b] + i];
+      }
+    }
+  }
+  for (int i = 0; i < eccLength; i++) {
+    for (int b = 0; b < blocks; b++) {
+      out[k++] = eccBlocks[b][i];
+    }
+  }
+}
+
+// ============================================================================
+// DATA ENCODING
+// ============================================================================
+
+// Mode indicators
+enum QrMode {
+  QR_NUMERIC = 1,
+  QR_ALPHANUMERIC = 2,
+  QR_BYTE = 4,
+};
+
+static const char QR_ALPHANUMERIC_CHARS[] =
+    "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+
+// Index in QR_ALPHANUMERIC_CHARS, or -1 (c must not be '\0')
+static int alphanumericValue(char c) {
+  const char *p = strchr(QR_ALPHANUMERIC_CHARS, c);
+  return p ? p - QR_ALPHANUMERIC_CHARS : -1;
+}
+
+static QrMode pickMode(const char *text, int length) {
+  bool numeric = true;
+  bool alphanumeric = true;
+  for (int i = 0; i < length; i++) {
+    if (text[i] < '0' || text[i] > '9') {
+      numeric = false;
+    }
+    if (alphanumericValue(text[i]) < 0) {
+      alphanumeric = false;
+    }
+  }
+  if (numeric) {
+    return QR_NUMERIC;
+  }
+  return alphanumeric ? QR_ALPHANUMERIC : QR_BYTE;
+}
+
+// Character count field width in versions 1-9
+static int countBits(QrMode mode) {
+  return mode == QR_NUMERIC ? 10 : mode == QR_ALPHANUMERIC ? 9 : 8;
+}
+
+static int segmentBits(QrMode mode, int length) {
+  int bits = 4 + countBits(mode);
+  if (mode == QR_NUMERIC) {
+    bits += length / 3 * 10 + (length % 3 == 2 ? 7 : length % 3 == 1 ? 4 : 0);
+  } else if (mode == QR_ALPHANUMERIC) {
+    bits += length / 2 * 11 + (length % 2) * 6;
+  } else {
+    bits += length * 8;
+  }
+  return bits;
+}
+
+// MSB-first bit appender over a zeroed buffer
+struct BitWriter {
+  uint8_t *bytes;
+  int length; // bits written
+
+  void put(uint32_t value, int count) {
+    for (int i = count - 1; i >= 0; i--) {
+      if ((value >> i) & 1) {
+        bytes[length >> 3] |= 0x80 >> (length & 7);
+      }
+      length++;
+    }
+  }
+};
+
+// One segment, terminator and padding filling `capacity` codewords
+static void writeData(uint8_t *data, int capacity, QrMode mode,
+                      const char *text, int length) {
+  memset(data, 0, capacity);
+  BitWriter out = {data, 0};
+  out.put(mode, 4);
+  out.put(length, countBits(mode));
+  if (mode == QR_NUMERIC) {
+    for (int i = 0; i < length; i += 3) {
+      const int digits = length - i < 3 ? length - i : 3;
+      int value = 0;
+      for (int j = 0; j < digits; j++) {
+        value = value * 10 + (text[i + j] - '0');
+      }
+      out.put(value, digits * 3 + 1);
+    }
+  } else if (mode == QR_ALPHANUMERIC) {
+    for (int i = 0; i < length; i += 2) {
+      if (i + 1 < length) {
+        out.put(alphanumericValue(text[i]) * 45 +
+                    alphanumericValue(text[i + 1]),
+                11);
+      } else {
+        out.put(alphanumericValue(text[i]), 6);
+      }
+    }
+  } else {
+    for (int i = 0; i < length; i++) {
+      out.put((uint8_t)text[i], 8);
+    }
+  }
+
+  const int bits = capacity * 8;
+  out.put(0, bits - out.length < 4 ? bits - out.length : 4);
+  out.put(0, (8 - (out.length & 7)) & 7);
+  for (uint8_t pad = 0xEC; out.length < bits; pad ^= 0xEC ^ 0x11) {
+    out.put(pad, 8);
+  }
+}
+
+// ============================================================================
+// MATRIX
+// Rows are padded to 64 words so the penalty pass can transpose them.
+// ============================================================================
+
+struct QrMatrix {
+  int size;
+  uint64_t modules[64];
+  uint64_t function[64]; // patterns and format bits; no data or masking
+};
+
+static inline uint64_t lowBits(int count) { return (1ULL << count) - 1; }
+
+static inline void setModule(uint64_t *rows, int x, int y, bool dark) {
+  if (dark) {
+    rows[y] |= 1ULL << x;
+  } else {
+    rows[y] &= ~(1ULL << x);
+  }
+}
+
+static void setFunctionModule(QrMatrix &matrix, int x, int y, bool dark) {
+  matrix.function[y] |= 1ULL << x;
+  setModule(matrix.modules, x, y, dark);
+}
+
+static void drawFinder(QrMatrix &matrix, int cx, int cy) {
+  for (int dy = -4; dy <= 4; dy++) {
+    for (int dx = -4; dx <= 4; dx++) {
+      const int x = cx + dx;
+      const int y = cy + dy;
+      if (x < 0 || y < 0 || x >= matrix.size || y >= matrix.size) {
+        continue;
+      }
+      const int distance = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+      setFunctionModule(matrix, x, y, distance != 2 && distance != 4);
+    }
+  }
+}
+
+static void drawAlignment(QrMatrix &matrix, int cx, int cy) {
+  for (int dy = -2; dy <= 2; dy++) {
+    for (int dx = -2; dx <= 2; dx++) {
+      const int distance = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+      setFunctionModule(matrix, cx + dx, cy + dy, distance != 1);
+    }
+  }
+}
+
+static void drawFunctionPatterns(QrMatrix &matrix, int version) {
+  const int size = matrix.size;
+  for (int i = 0; i < size; i++) {
+    setFunctionModule(matrix, 6, i, i % 2 == 0);
+    setFunctionModule(matrix, i, 6, i % 2 == 0);
+  }
+  drawFinder(matrix, 3, 3);
+  drawFinder(matrix, size - 4, 3);
+  drawFinder(matrix, 3, size - 4);
+  // Up to version 6 the only alignment pattern clear of the finders is the
+  // bottom-right one
+  if (version >= 2) {
+    drawAlignment(matrix, size - 7, size - 7);
+  }
+
+  // Reserve the format information areas; the bits depend on the mask
+  for (int i = 0; i <= 8; i++) {
+    matrix.function[8] |= 1ULL << i;
+    matrix.function[i] |= 1ULL << 8;
+  }
+  for (int i = 0; i < 8; i++) {
+    matrix.function[8] |= 1ULL << (size - 1 - i);
+    matrix.function[size - 1 - i] |= 1ULL << 8;
+  }
+}
+
+// Both copies of the 15-bit format information, plus the dark module
+static void drawFormatBits(uint64_t *rows, int size, QrEcc ecc, int mask) {
+  const int data = QR_ECC_FORMAT[ecc] << 3 | mask;
+  int remainder = data;
+  for (int i = 0; i < 10; i++) {
+    remainder = (remainder << 1) ^ ((remainder >> 9) * 0x537);
+  }
+  const int bits = (data << 10 | remainder) ^ 0x5412;
+
+  // Around the top-left finder
+  for (int i = 0; i <= 5; i++) {
+    setModule(rows, 8, i, (bits >> i) & 1);
+  }
+  setModule(rows, 8, 7, (bits >> 6) & 1);
+  setModule(rows, 8, 8, (bits >> 7) & 1);
+  setModule(rows, 7, 8, (bits >> 8) & 1);
+  for (int i = 9; i < 15; i++) {
+    setModule(rows, 14 - i, 8, (bits >> i) & 1);
+  }
+
+  // Split between the top-right and bottom-left finders
+  for (int i = 0; i < 8; i++) {
+    setModule(rows, size - 1 - i, 8, (bits >> i) & 1);
+  }
+  for (int i = 8; i < 15; i++) {
+    setModule(rows, 8, size - 15 + i, (bits >> i) & 1);
+  }
+  setModule(rows, 8, size - 8, true);
+}
+
+// Codeword bits in the two-column zigzag from the bottom-right corner,
+// skipping function modules. Remainder modules stay light.
+static void drawCodewords(QrMatrix &matrix, const uint8_t *codewords,
+                          int count) {
+  const int size = matrix.size;
+  const int bits = count * 8;
+  int i = 0;
+  for (int right = size - 1; right >= 1; right -= 2) {
+    if (right == 6) {
+      right = 5; // the vertical timing pattern
+    }
+    const bool upward = ((right + 1) & 2) == 0;
+    for (int step = 0; step < size; step++) {
+      const int y = upward ? size - 1 - step : step;
+      for (int j = 0; j < 2 && i < bits; j++) {
+        const int x = right - j;
+        if ((matrix.function[y] >> x) & 1) {
+          continue;
+        }
+        setModule(matrix.modules, x, y,
+                  (codewords[i >> 3] >> (7 - (i & 7))) & 1);
+        i++;
+      }
+    }
+  }
+}
+
+// ============================================================================
+// MASKING
+// ============================================================================
+
+static bool maskInverts(int mask, int x, int y) {
+  switch (mask) {
+  case 0:
+    return (x + y) % 2 == 0;
+  case 1:
+    return y % 2 == 0;
+  case 2:
+    return x % 3 == 0;
+  case 3:
+    return (x + y) % 3 == 0;
+  case 4:
+    return (x / 3 + y / 2) % 2 == 0;
+  case 5:
+    return x * y % 2 + x * y % 3 == 0;
+  case 6:
+    return (x * y % 2 + x * y % 3) % 2 == 0;
+  default:
+    return ((x + y) % 2 + x * y % 3) % 2 == 0;
+  }
+}
+
+// Row y of a mask. Every mask repeats every 6 columns, so 6 modules are
+// evaluated and copied across the word.
+static uint64_t maskRow(int mask, int y) {
+  uint64_t row = 0;
+  for (int x = 0; x < 6; x++) {
+    if (maskInverts(mask, x, y)) {
+      row |= 1ULL << x;
+    }
+  }
+  row |= row << 6;
+  row |= row << 12;
+  row |= row << 24;
+  row |= row << 48;
+  return row;
+}
+
+// The final symbol for one mask: data modules masked, format bits drawn
+static void applyMask(const QrMatrix &matrix, QrEcc ecc, int mask,
+                      uint64_t *rows) {
+  const int size = matrix.size;
+  for (int y = 0; y < 64; y++) {
+    rows[y] = 0;
+  }
+  for (int y = 0; y < size; y++) {
+    const uint64_t data = ~matrix.function[y] & lowBits(size);
+    rows[y] = matrix.modules[y] ^ (maskRow(mask, y) & data);
+  }
+  drawFormatBits(rows, size, ecc, mask);
+}
+
+// ============================================================================
+// MASK PENALTY
+// Scored a whole row (or column, after a transpose) at a time: bit x of
+// ~(line ^ (line >> 1)) says modules x and x + 1 match, and patterns are
+// found by ANDing shifted copies of the line.
+// ============================================================================
+
+#define PENALTY_N2 3
+#define PENALTY_N3 40
+#define PENALTY_N4 10
+
+// Dark-light-dark x3-light-dark with four light modules before it, and the
+// same followed by four light modules; bit k is module k of the window
+#define FINDER_LIGHT_BEFORE 0x5D0
+#define FINDER_LIGHT_AFTER 0x05D
+#define FINDER_WINDOW 11
+
+static inline int popcount(uint64_t bits) { return __builtin_popcountll(bits); }
+
+// Bit x set where the window starting at bit x of line equals pattern
+static uint64_t matchWindows(uint64_t line, int pattern) {
+  uint64_t match = ~0ULL;
+  for (int k = 0; k < FINDER_WINDOW; k++) {
+    match &= (pattern >> k) & 1 ? line >> k : ~(line >> k);
+  }
+  return match;
+}
+
+// Runs of five or more (N1) and finder-like patterns (N3) in one line
+static int linePenalty(uint64_t line, int size) {
+  const uint64_t same = ~(line ^ (line >> 1)) & lowBits(size - 1);
+  const uint64_t runs = same & (same >> 1) & (same >> 2) & (same >> 3);
+  // A run of n >= 5 scores 3 + (n - 5): one per five-module window it
+  // contains, plus two per run
+  int score = popcount(runs) + 2 * popcount(runs & ~(runs << 1));
+
+  // Four light modules of margin on each side; outside the symbol is light
+  const uint64_t padded = line << 4;
+  const uint64_t windows = lowBits(size - 2);
+  score += PENALTY_N3 *
+           (popcount(matchWindows(padded, FINDER_LIGHT_BEFORE) & windows) +
+            popcount(matchWindows(padded, FINDER_LIGHT_AFTER) & windows));
+  return score;
+}
+
+// In-place transpose of a 64x64 bit matrix (bit x of word y <-> bit y of
+// word x) by swapping ever smaller off-diagonal blocks
+static void transpose64(uint64_t *a) {
+  uint64_t m = 0x00000000FFFFFFFFULL;
+  for (int j = 32; j != 0; j >>= 1, m ^= m << j) {
+    for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+      const uint64_t t = ((a[k] >> j) ^ a[k | j]) & m;
+      a[k] ^= t << j;
+      a[k | j] ^= t;
+    }
+  }
+}
+
+static int penaltyScore(const uint64_t *rows, int size) {
+  uint64_t columns[64];
+  memcpy(columns, rows, sizeof(columns));
+  transpose64(columns);
+
+  int score = 0;
+  int dark = 0;
+  for (int i = 0; i < size; i++) {
+    score += linePenalty(rows[i], size) + linePenalty(columns[i], size);
+    dark += popcount(rows[i]);
+  }
+
+  // 2x2 blocks of one colour (N2)
+  for (int y = 0; y + 1 < size; y++) {
+    const uint64_t a = rows[y];
+    const uint64_t b = rows[y + 1];
+    const uint64_t blocks =
+        ~(a ^ b) & ~(a ^ (a >> 1)) & ~(b ^ (b >> 1)) & lowBits(size - 1);
+    score += PENALTY_N2 * popcount(blocks);
+  }
+
+  // Dark share away from 50%, in steps of 5% (N4)
+  const int total = size * size;
+  const int k = (abs(dark * 20 - total * 10) + total - 1) / total - 1;
+  return score + PENALTY_N4 * k;
+}
+
+// ============================================================================
+// ENCODER
+// ============================================================================
+
+bool encodeQrCode(QrCode &qr, const char *text, QrEcc ecc, int mask) {
+  qr.version = 0;
+  qr.size = 0;
+  if (mask < -1 || mask > 7) {
+    return false;
+  }
+
+  const int length = strlen(text);
+  const QrMode mode = pickMode(text, length);
+  const int bits = segmentBits(mode, length);
+  int version = 1;
+  while (version <= QR_MAX_VERSION && dataCodewords(version, ecc) * 8 < bits) {
+    version++;
+  }
+  if (version > QR_MAX_VERSION) {
+    return false;
+  }
+
+  uint8_t data[QR_MAX_DATA_CODEWORDS];
+  uint8_t codewords[QR_MAX_CODEWORDS];
+  writeData(data, dataCodewords(version, ecc), mode, text, length);
+  addEccAndInterleave(data, version, ecc, codewords);
+
+  QrMatrix matrix;
+  matrix.size = 17 + 4 * version;
+  memset(matrix.modules, 0, sizeof(matrix.modules));
+  memset(matrix.function, 0, sizeof(matrix.function));
+  drawFunctionPatterns(matrix, version);
+  drawCodewords(matrix, codewords, QR_TOTAL_CODEWORDS[version]);
+
+  uint64_t rows[64];
+  if (mask < 0) {
+    int best = INT_MAX;
+    for (int candidate = 0; candidate < 8; candidate++) {
+      applyMask(matrix, ecc, candidate, rows);
+      const int score = penaltyScore(rows, matrix.size);
+      if (score < best) {
+        best = score;
+        mask = candidate;
+      }
+    }
+  }
+  applyMask(matrix, ecc, mask, rows);
+
+  qr.version = version;
+  qr.size = matrix.size;
+  qr.ecc = ecc;
+  qr.mask = mask;
+  memcpy(qr.rows, rows, sizeof(qr.rows));
+  return true;
+}
+
+// ============================================================================
+// RENDERING
+// A module row (or column) is expanded to dots once, then written to each of
+// its moduleSize dot rows (or columns) a byte at a time.
+// ============================================================================
+
+// Set bits [x1, x2) of a packed MSB-first buffer
+static void setBits(uint8_t *bits, int x1, int x2) {
+  if (x1 >= x2) {
+    return;
+  }
+  const int first = x1 >> 3;
+  const int last = (x2 - 1) >> 3;
+  const uint8_t head = 0xFF >> (x1 & 7);
+  const uint8_t tail = 0xFF << (7 - ((x2 - 1) & 7));
+  if (first == last) {
+    bits[first] |= head & tail;
+    return;
+  }
+  bits[first] |= head;
+  if (last - first > 1) {
+    memset(bits + first + 1, 0xFF, last - first - 1);
+  }
+  bits[last] |= tail;
+}
+
+// Expand one line of modules (bit m = module m) into dots for the part
+// [from, to) of a line whose quiet zone starts at dot `origin`. Dot p goes to
+// bit p - base.
+static void expandModules(uint8_t *bits, int base, int from, int to,
+                          int origin, uint64_t line, int size,
+                          int moduleSize) {
+  for (int m = 0; m < size; m++) {
+    if (!((line >> m) & 1)) {
+      continue;
+    }
+    int p1 = origin + (QR_QUIET_ZONE + m) * moduleSize;
+    int p2 = p1 + moduleSize;
+    if (p1 < from)
+      p1 = from;
+    if (p2 > to)
+      p2 = to;
+    setBits(bits, p1 - base, p2 - base);
+  }
+}
+
+static uint64_t qrColumn(const QrCode &qr, int x) {
+  uint64_t column = 0;
+  for (int y = 0; y < qr.size; y++) {
+    column |= ((qr.rows[y] >> x) & 1) << y;
+  }
+  return column;
+}
+
+template <int W, int H>
+void drawQrCode(BasicBitmap<W, H> &bitmap, const QrCode &qr, int x, int y,
+                int moduleSize) {
+  if (moduleSize <= 0) {
+    return;
+  }
+  const ClipRect &clip = bitmap.clip.rect;
+  const int extent = qrCodeWidth(qr, moduleSize);
+  const int x1 = x > clip.x1 ? x : clip.x1;
+  const int x2 = x + extent < clip.x2 ? x + extent : clip.x2;
+  const int y1 = y > clip.y1 ? y : clip.y1;
+  const int y2 = y + extent < clip.y2 ? y + extent : clip.y2;
+  if (x1 >= x2 || y1 >= y2) {
+    return;
+  }
+
+  uint8_t bits[BasicBitmap<W, H>::STRIDE];
+  uint8_t written[BasicBitmap<W, H>::STRIDE];
+  clearBuffer(written, sizeof(written));
+  setBits(written, x1, x2);
+  const int firstByte = x1 >> 3;
+  const int lastByte = (x2 - 1) >> 3;
+
+  for (int row = y1; row < y2;) {
+    const int m = (row - y) / moduleSize - QR_QUIET_ZONE;
+    int end = y + (m + QR_QUIET_ZONE + 1) * moduleSize;
+    if (end > y2)
+      end = y2;
+    clearBuffer(bits, sizeof(bits));
+    if (m >= 0 && m < qr.size) {
+      expandModules(bits, 0, x1, x2, x, qr.rows[m], qr.size, moduleSize);
+    }
+    for (; row < end; row++) {
+      uint8_t *dest = bitmapRow(bitmap, row);
+      for (int b = firstByte; b <= lastByte; b++) {
+        dest[b] = (dest[b] & ~written[b]) | bits[b];
+      }
+    }
+  }
+  markDirty(bitmap, x1, x2);
+}
+
+template <int W, int H>
+void drawQrCode(PrinterBitmap<W, H> &bitmap, const QrCode &qr, int x, int y,
+                int moduleSize) {
+  if (moduleSize <= 0) {
+    return;
+  }
+  const ClipRect &clip = bitmap.clip.rect;
+  const int extent = qrCodeWidth(qr, moduleSize);
+  const int x1 = x > clip.x1 ? x : clip.x1;
+  const int x2 = x + extent < clip.x2 ? x + extent : clip.x2;
+  const int y1 = y > clip.y1 ? y : clip.y1;
+  const int y2 = y + extent < clip.y2 ? y + extent : clip.y2;
+  if (x1 >= x2 || y1 >= y2) {
+    return;
+  }
+
+  uint8_t bits[PrinterBitmap<W, H>::BYTES_PER_COLUMN];
+  for (int col = x1; col < x2;) {
+    const int m = (col - x) / moduleSize - QR_QUIET_ZONE;
+    int end = x + (m + QR_QUIET_ZONE + 1) * moduleSize;
+    if (end > x2)
+      end = x2;
+    const bool inSymbol = m >= 0 && m < qr.size;
+    if (inSymbol) {
+      clearBuffer(bits, sizeof(bits));
+      expandModules(bits, y1, y1, y2, y, qrColumn(qr, m), qr.size,
+                    moduleSize);
+    }
+    for (; col < end; col++) {
+      fillColumnSpan(bitmap, col, y1, y2, false);
+      if (inSymbol) {
+        blitColumnBits(bitmap, col, y1, bits, y2 - y1);
+      }
+    }
+  }
+}
+
+// ============================================================================
+// EXPLICIT INSTANTIATIONS (one per tape canvas)
+// ============================================================================
+
+#define INSTANTIATE_QR_CODE(W, H)                                              \
+  template void drawQrCode(BasicBitmap<W, H> &, const QrCode &, int, int,      \
+                           int);                                               \
+  template void drawQrCode(PrinterBitmap<W, H> &, const QrCode &, int, int,    \
+                           int);
+
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_QR_CODE)
+
+#undef INSTANTIATE_QR_CODE
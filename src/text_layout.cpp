@@ -0,0 +1,349 @@
+#include <text_layout.h>
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+int textWidth(const Font &font, const char *str, int length) {
+  const char *end = length < 0 ? nullptr : str + length;
+  int pen = 0;
+  int right = 0;
+  while (end ? str < end : *str != '\0') {
+    const Glyph &glyph = findGlyph(font, nextCodepoint(str));
+    if (glyph.width > 0 && pen + glyph.left + glyph.width > right) {
+      right = pen + glyph.left + glyph.width;
+    }
+    pen += glyph.advance;
+  }
+  return right;
+}
+
+static int advanceOf(const Font &font, const char *str, int length) {
+  const char *end = str + length;
+  int pen = 0;
+  while (str < end) {
+    pen += findGlyph(font, nextCodepoint(str)).advance;
+  }
+  return pen;
+}
+
+// Longest prefix of str[0, length), in bytes, that fits in width columns.
+// With tail > 0 the prefix is followed by that many columns of ink drawn at
+// its pen end.
+static int fitPrefix(const Font &font, const char *str, int length, int width,
+                     int tail) {
+  const char *p = str;
+  int pen = 0;
+  int right = 0;
+  while (p < str + length) {
+    const char *start = p;
+    const Glyph &glyph = findGlyph(font, nextCodepoint(p));
+    int ink = right;
+    if (glyph.width > 0 && pen + glyph.left + glyph.width > ink) {
+      ink = pen + glyph.left + glyph.width;
+    }
+    const int next = pen + glyph.advance;
+    if ((tail > 0 && next + tail > width) || ink > width) {
+      return start - str;
+    }
+    pen = next;
+    right = ink;
+  }
+  return length;
+}
+
+static int trimTrailingSpaces(const char *str, int length) {
+  while (length > 0 && str[length - 1] == ' ') {
+    length--;
+  }
+  return length;
+}
+
+// Bytes of str[0, length) to put on a wrapped line: up to the last space
+// that fits, or as many characters as fit when a single word is too wide.
+// Always at least one character, so layout makes progress.
+static int breakLength(const Font &font, const char *str, int length,
+                       int width) {
+  int fit = fitPrefix(font, str, length, width, 0);
+  if (fit == 0) {
+    const char *p = str;
+    nextCodepoint(p);
+    return p - str;
+  }
+  if (fit < length && str[fit] != ' ') {
+    for (int i = fit - 1; i > 0; i--) {
+      if (str[i] == ' ') {
+        return i;
+      }
+    }
+  }
+  return fit;
+}
+
+// ============================================================================
+// LAYOUT
+// ============================================================================
+
+// Cut a line down to what fits, ending it with ELLIPSIS when the box asks
+static void cutLine(TextLine &line, const Font &font, int available,
+                    const TextBox &box) {
+  if (box.ellipsis) {
+    const int tail = textWidth(font, ELLIPSIS);
+    line.length = trimTrailingSpaces(
+        line.start, fitPrefix(font, line.start, available, box.width, tail));
+    line.ellipsis = true;
+    line.width = advanceOf(font, line.start, line.length) + tail;
+  } else {
+    line.length = fitPrefix(font, line.start, available, box.width, 0);
+    line.width = textWidth(font, line.start, line.length);
+  }
+}
+
+int layoutText(TextLayout &layout, const Font &font, const char *str,
+               const TextBox &box) {
+  layout.font = &font;
+  layout.scale = 1;
+  layout.lineCount = 0;
+  layout.width = 0;
+  layout.height = 0;
+  layout.truncated = false;
+  if (!*str) {
+    return 0;
+  }
+
+  const int pitch = font.height + box.lineSpacing;
+  int maxLines = MAX_LAYOUT_LINES;
+  if (box.height > 0 && pitch > 0) {
+    const int fit = (box.height + box.lineSpacing) / pitch;
+    if (fit < maxLines) {
+      maxLines = fit < 1 ? 1 : fit;
+    }
+  }
+
+  const char *p = str;
+  while (layout.lineCount < maxLines) {
+    int end = 0;
+    while (p[end] != '\0' && p[end] != '\n') {
+      end++;
+    }
+
+    int length = end;
+    const char *next = p + end + (p[end] == '\n' ? 1 : 0);
+    const bool tooWide = textWidth(font, p, end) > box.width;
+    if (box.wrap && tooWide) {
+      length = breakLength(font, p, end, box.width);
+      next = p + length;
+      while (*next == ' ') {
+        next++;
+      }
+      // The break used up the paragraph: its newline ends this line too
+      if (next == p + end && *next == '\n') {
+        next++;
+      }
+    }
+
+    TextLine &line = layout.lines[layout.lineCount++];
+    line.start = p;
+    line.length = trimTrailingSpaces(p, length);
+    line.ellipsis = false;
+    line.width = textWidth(font, p, line.length);
+
+    const bool lastLine = layout.lineCount == maxLines;
+    if (lastLine && *next != '\0') {
+      // Text left over: end this line with as much of its paragraph as fits
+      cutLine(line, font, end, box);
+      layout.truncated = true;
+    } else if (!box.wrap && tooWide) {
+      cutLine(line, font, end, box);
+      layout.truncated = true;
+    }
+
+    p = next;
+    if (*p == '\0') {
+      break;
+    }
+  }
+
+  for (int i = 0; i < layout.lineCount; i++) {
+    TextLine &line = layout.lines[i];
+    line.x = box.x;
+    if (box.align == ALIGN_CENTER) {
+      line.x += (box.width - line.width) / 2;
+    } else if (box.align == ALIGN_RIGHT) {
+      line.x += box.width - line.width;
+    }
+    line.y = box.y + i * pitch;
+    if (line.width > layout.width) {
+      layout.width = line.width;
+    }
+  }
+  layout.height = textHeight(font, layout.lineCount, box.lineSpacing);
+  return layout.lineCount;
+}
+
+// ============================================================================
+// AUTO-FIT
+// ============================================================================
+
+struct FitCandidate {
+  const Font *font;
+  int scale;
+};
+
+static int lineHeightOf(const FitCandidate &candidate) {
+  return candidate.font->height * candidate.scale;
+}
+
+// True if a wrapped line ends inside a word
+static bool splitsWord(const TextLayout &layout) {
+  for (int i = 0; i < layout.lineCount; i++) {
+    const TextLine &line = layout.lines[i];
+    const char next = line.start[line.length];
+    if (!line.ellipsis && next != '\0' && next != ' ' && next != '\n') {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Lay out at one candidate in the box shrunk by its scale; true if it fits
+static bool layoutAt(TextLayout &layout, const FitCandidate &candidate,
+                     const char *str, const TextBox &box, bool ellipsis,
+                     bool allowSplit) {
+  TextBox unscaled = box;
+  unscaled.x = 0;
+  unscaled.y = 0;
+  unscaled.width = box.width / candidate.scale;
+  unscaled.height = box.height / candidate.scale;
+  unscaled.ellipsis = ellipsis;
+  layoutText(layout, *candidate.font, str, unscaled);
+  return !layout.truncated && layout.width <= unscaled.width &&
+         (box.height <= 0 || layout.height <= unscaled.height) &&
+         (allowSplit || !splitsWord(layout));
+}
+
+// Move a layout made by layoutAt to canvas coordinates in box
+static void placeScaled(TextLayout &layout, const TextBox &box, int scale) {
+  const int pitch = (layout.font->height + box.lineSpacing) * scale;
+  const int height = layout.height * scale;
+  const int top =
+      box.y + (box.height > height ? (box.height - height) / 2 : 0);
+
+  layout.scale = scale;
+  layout.width = 0;
+  layout.height = height;
+  for (int i = 0; i < layout.lineCount; i++) {
+    TextLine &line = layout.lines[i];
+    line.width *= scale;
+    line.x = box.x;
+    if (box.align == ALIGN_CENTER) {
+      line.x += (box.width - line.width) / 2;
+    } else if (box.align == ALIGN_RIGHT) {
+      line.x += box.width - line.width;
+    }
+    line.y = top + i * pitch;
+    if (line.width > layout.width) {
+      layout.width = line.width;
+    }
+  }
+}
+
+bool fitText(TextLayout &layout, const Font *const *fonts, int fontCount,
+             const char *str, const TextBox &box) {
+  // Candidates by increasing line height (insertion sort; there are few)
+  FitCandidate candidates[MAX_FIT_CANDIDATES];
+  int count = 0;
+  for (int f = 0; f < fontCount; f++) {
+    for (int scale = 1; count < MAX_FIT_CANDIDATES; scale++) {
+      const FitCandidate candidate = {fonts[f], scale};
+      if (scale > 1 && lineHeightOf(candidate) > box.height) {
+        break;
+      }
+      int i = count++;
+      while (i > 0 &&
+             lineHeightOf(candidates[i - 1]) > lineHeightOf(candidate)) {
+        candidates[i] = candidates[i - 1];
+        i--;
+      }
+      candidates[i] = candidate;
+    }
+  }
+  if (count == 0) {
+    layout.lineCount = 0;
+    return false;
+  }
+
+  // Prefer sizes that keep words whole; break inside words only if no size
+  // fits otherwise
+  int best = -1;
+  for (int pass = 0; pass < 2 && best < 0; pass++) {
+    int lo = 0;
+    int hi = count - 1;
+    while (lo <= hi) {
+      const int mid = (lo + hi) / 2;
+      if (layoutAt(layout, candidates[mid], str, box, false, pass == 1)) {
+        best = mid;
+        lo = mid + 1;
+      } else {
+        hi = mid - 1;
+      }
+    }
+  }
+
+  const FitCandidate &chosen = candidates[best < 0 ? 0 : best];
+  layoutAt(layout, chosen, str, box, box.ellipsis, true);
+  placeScaled(layout, box, chosen.scale);
+  return best >= 0;
+}
+
+// ============================================================================
+// RASTERIZATION
+// ============================================================================
+
+template <typename BitmapT>
+static void drawLines(BitmapT &bitmap, const TextLayout &layout) {
+  const Font &font = *layout.font;
+  for (int i = 0; i < layout.lineCount; i++) {
+    const TextLine &line = layout.lines[i];
+    int x = line.x;
+    const char *p = line.start;
+    if (layout.scale > 1) {
+      while (p < line.start + line.length) {
+        x += drawGlyphScaled(bitmap, font, nextCodepoint(p), x, line.y,
+                             layout.scale);
+      }
+      if (line.ellipsis) {
+        drawTextScaled(bitmap, font, ELLIPSIS, x, line.y, layout.scale);
+      }
+      continue;
+    }
+    while (p < line.start + line.length) {
+      x += drawGlyph(bitmap, font, nextCodepoint(p), x, line.y);
+    }
+    if (line.ellipsis) {
+      drawText(bitmap, font, ELLIPSIS, x, line.y);
+    }
+  }
+}
+
+template <int W, int H>
+void drawLayout(BasicBitmap<W, H> &bitmap, const TextLayout &layout) {
+  drawLines(bitmap, layout);
+}
+
+template <int W, int H>
+void drawLayout(PrinterBitmap<W, H> &bitmap, const TextLayout &layout) {
+  drawLines(bitmap, layout);
+}
+
+// ============================================================================
+// EXPLICIT INSTANTIATIONS (one per tape canvas)
+// ============================================================================
+
+#define INSTANTIATE_TEXT_LAYOUT(W, H)                                          \
+  template void drawLayout(BasicBitmap<W, H> &, const TextLayout &);           \
+  template void drawLayout(PrinterBitmap<W, H> &, const TextLayout &);
+
+FOR_EACH_TAPE_BITMAP(INSTANTIATE_TEXT_LAYOUT)
+
+#undef INSTANTIATE_TEXT_LAYOUT
@@ -0,0 +1,561 @@
+#!/usr/bin/env python3
+"""Compile a bitmap font into a constexpr C++ header (include/fonts/*.h).
+
+Usage: fontc.py [options] SOURCE OUTPUT
+
+  --subset SPEC        only emit these code points: comma-separated values or
+                       FIRST-LAST ranges, decimal or 0x hex
+                       (e.g. 0x20-0x7E,0xB0)
+  --subset-from FILE   only emit the characters used in a UTF-8 text file
+  --name NAME          identifier prefix instead of the source's font name
+  --no-columns         omit the column-major table; the renderer then rotates
+                       glyphs at runtime on first printer-format use
+  --packed             LZSS-compress the glyph rows in blocks that are
+                       unpacked on demand into the runtime glyph cache (for
+                       large fonts such as CJK; implies --no-columns)
+
+Both subset options may be given; the fallback glyph is always kept.
+
+SOURCE is a BDF font (*.bdf) or the text glyph format below, one directive per
+line, blocks separated by blank lines:
+
+  FONT name            identifier prefix for the generated tables
+  HEIGHT n             rows in the line box
+  ASCENT n             rows from the top of the line box to the baseline
+  DEFAULT_TOP n        line box row grids start on unless TOP is given
+  FALLBACK cp          glyph drawn for code points the font lacks
+
+  GLYPH cp [label]     a glyph, followed by optional TOP n / ADVANCE n and
+                       grid rows of '.' and '#' (may stop above the bottom)
+  DEFINE name          same, but only for use in COMPOSE (not emitted)
+  COMPOSE cp base mark ORs mark centred over base; base is a single
+                       character or a DEFINE name
+
+Advance defaults to the grid width plus one. Comment lines start with '#';
+the leading comment block is copied into the header.
+
+Each glyph is trimmed to its ink and stored twice: rows MSB-first padded to
+whole bytes (drawn with blit on row-major canvases), and columns of the
+trimmed height MSB-first padded to whole bytes (ORed straight into
+printer-format columns).
+"""
+
+import os
+import sys
+
+
+class FontError(Exception):
+    pass
+
+
+class Source:
+    def __init__(self):
+        self.name = None
+        self.height = None
+        self.ascent = None
+        self.default_top = 0
+        self.fallback = None
+        self.comments = []
+        self.glyphs = {}  # codepoint -> (label, grid)
+        self.defines = {}  # name -> grid
+        self.composes = []  # (codepoint, base, mark)
+
+
+# A grid is (top, advance, rows, origin): rows is a list of strings of '.'/'#'
+# and origin the pen-relative column of their first character
+
+
+def parse(path):
+    src = Source()
+    block = None  # (kind, key, label, top, advance, rows)
+
+    def finish():
+        if block is None:
+            return
+        kind, key, label, top, advance, rows = block
+        widths = set(len(r) for r in rows)
+        if len(widths) > 1:
+            raise FontError('%s: ragged grid rows' % label)
+        grid = (top, advance, rows, 0)
+        if kind == 'GLYPH':
+            if key in src.glyphs:
+                raise FontError('duplicate glyph %d' % key)
+            src.glyphs[key] = (label, grid)
+        else:
+            src.defines[key] = grid
+
+    in_header = True
+    with open(path) as f:
+        for lineno, raw in enumerate(f, 1):
+            line = raw.rstrip('\n')
+            if block is not None and line and set(line) <= set('.#'):
+                block[5].append(line)
+                continue
+            if line.startswith('#'):
+                if in_header:
+                    src.comments.append(line[1:].strip() if len(line) > 1
+                                        else '')
+                continue
+            in_header = False
+            if not line.strip():
+                finish()
+                block = None
+                continue
+
+            words = line.split()
+            keyword = words[0]
+            if keyword in ('GLYPH', 'DEFINE'):
+                finish()
+                key = int(words[1]) if keyword == 'GLYPH' else words[1]
+                label = ' '.join(words[2:]) if keyword == 'GLYPH' else key
+                block = [keyword, key, label, None, None, []]
+            elif keyword == 'TOP' and block is not None:
+                block[3] = int(words[1])
+            elif keyword == 'ADVANCE' and block is not None:
+                block[4] = int(words[1])
+            elif keyword == 'COMPOSE':
+                src.composes.append((int(words[1]), words[2], words[3]))
+            elif keyword == 'FONT':
+                src.name = words[1]
+            elif keyword == 'HEIGHT':
+                src.height = int(words[1])
+            elif keyword == 'ASCENT':
+                src.ascent = int(words[1])
+            elif keyword == 'DEFAULT_TOP':
+                src.default_top = int(words[1])
+            elif keyword == 'FALLBACK':
+                src.fallback = int(words[1])
+            else:
+                raise FontError('%s:%d: cannot parse %r' % (path, lineno, line))
+    finish()
+
+    if src.name is None or src.height is None or src.ascent is None:
+        raise FontError('FONT, HEIGHT and ASCENT are required')
+    return src
+
+
+def parse_bdf(path):
+    """Read a BDF font. The line box is FONT_ASCENT + FONT_DESCENT rows."""
+    src = Source()
+    base = os.path.splitext(os.path.basename(path))[0]
+    base = ''.join(c if c.isalnum() else '_' for c in base).lower()
+    src.name = 'font_' + base
+    descent = None
+    glyph = None  # [label, codepoint, advance, bbx, rows]
+    in_bitmap = False
+
+    with open(path) as f:
+        for lineno, raw in enumerate(f, 1):
+            words = raw.split()
+            if not words:
+                continue
+            keyword = words[0]
+            if in_bitmap:
+                if keyword == 'ENDCHAR':
+                    in_bitmap = False
+                    add_bdf_glyph(src, *glyph)
+                    glyph = None
+                else:
+                    glyph[4].append(keyword)
+                continue
+            if keyword == 'COMMENT':
+                src.comments.append(raw.strip()[len('COMMENT'):].strip())
+            elif keyword == 'FONT_ASCENT':
+                src.ascent = int(words[1])
+            elif keyword == 'FONT_DESCENT':
+                descent = int(words[1])
+            elif keyword == 'DEFAULT_CHAR':
+                src.fallback = int(words[1])
+            elif keyword == 'STARTCHAR':
+                if src.ascent is None or descent is None:
+                    raise FontError('%s:%d: FONT_ASCENT and FONT_DESCENT '
+                                    'must precede the glyphs' % (path, lineno))
+                src.height = src.ascent + descent
+                glyph = [' '.join(words[1:]), -1, 0, (0, 0, 0, 0), []]
+            elif keyword == 'ENCODING' and glyph is not None:
+                glyph[1] = int(words[1])
+            elif keyword == 'DWIDTH' and glyph is not None:
+                glyph[2] = int(words[1])
+            elif keyword == 'BBX' and glyph is not None:
+                glyph[3] = tuple(int(w) for w in words[1:5])
+            elif keyword == 'BITMAP' and glyph is not None:
+                in_bitmap = True
+
+    if src.height is None:
+        raise FontError('%s: no glyphs' % path)
+    return src
+
+
+def add_bdf_glyph(src, label, cp, advance, bbx, hex_rows):
+    if cp < 0 or cp > 0xFFFF:
+        return
+    w, h, xoff, yoff = bbx
+    rows = []
+    for hex_row in hex_rows[:h]:
+        bits = bin(int(hex_row, 16))[2:].zfill(len(hex_row) * 4)
+        rows.append(''.join('#' if b == '1' else '.' for b in bits[:w]))
+    top = src.ascent - (yoff + h)
+    if top < 0 or top + len(rows) > src.height:
+        sys.stderr.write('fontc: %s (U+%04X) clipped to the line box\n' %
+                         (label, cp))
+        rows = rows[max(0, -top):src.height - top]
+        top = max(0, top)
+    src.glyphs[cp] = (label, (top, advance, rows, xoff))
+
+
+def to_matrix(src, grid):
+    """Expand a grid to (width, advance, HEIGHT rows of bools, origin)."""
+    top, advance, rows, origin = grid
+    if top is None:
+        top = src.default_top
+    width = len(rows[0]) if rows else 0
+    if top < 0 or top + len(rows) > src.height:
+        raise FontError('grid does not fit the %d-row line box' % src.height)
+    matrix = [[False] * width for _ in range(src.height)]
+    for i, row in enumerate(rows):
+        matrix[top + i] = [c == '#' for c in row]
+    if advance is None:
+        advance = width + 1
+    return width, advance, matrix, origin
+
+
+def lookup(src, token):
+    if token in src.defines:
+        return to_matrix(src, src.defines[token])
+    if len(token) == 1 and ord(token) in src.glyphs:
+        return to_matrix(src, src.glyphs[ord(token)][1])
+    raise FontError('unknown compose component %r' % token)
+
+
+def compose(src, base, mark):
+    bw, _, bm, _ = lookup(src, base)
+    mw, _, mm, _ = lookup(src, mark)
+    width = max(bw, mw)
+    matrix = [[False] * width for _ in range(src.height)]
+    for m, w in ((bm, bw), (mm, mw)):
+        dx = (width - w) // 2
+        for y in range(src.height):
+            for x in range(w):
+                if m[y][x]:
+                    matrix[y][x + dx] = True
+    return width, width + 1, matrix, 0
+
+
+def build(src):
+    """Return sorted [(codepoint, label, width, advance, matrix, origin)]."""
+    glyphs = {}
+    for cp, (label, grid) in src.glyphs.items():
+        glyphs[cp] = (label,) + to_matrix(src, grid)
+    for cp, base, mark in src.composes:
+        if cp in glyphs:
+            raise FontError('duplicate glyph %d' % cp)
+        glyphs[cp] = ('%s + %s' % (base, mark),) + compose(src, base, mark)
+    return [(cp,) + glyphs[cp] for cp in sorted(glyphs)]
+
+
+def trim(width, matrix):
+    """Bounding box of the set pixels: (left, top, w, h)."""
+    ys = [y for y, row in enumerate(matrix) if any(row)]
+    xs = [x for x in range(width) if any(row[x] for row in matrix)]
+    if not ys:
+        return 0, 0, 0, 0
+    return xs[0], ys[0], xs[-1] - xs[0] + 1, ys[-1] - ys[0] + 1
+
+
+def pack_rows(matrix, left, top, w, h):
+    out = []
+    for y in range(top, top + h):
+        for bx in range(0, w, 8):
+            byte = 0
+            for i in range(8):
+                if bx + i < w and matrix[y][left + bx + i]:
+                    byte |= 0x80 >> i
+            out.append(byte)
+    return out
+
+
+def pack_columns(matrix, left, top, w, h):
+    out = []
+    for x in range(left, left + w):
+        for by in range(0, h, 8):
+            byte = 0
+            for i in range(8):
+                if by + i < h and matrix[top + by + i][x]:
+                    byte |= 0x80 >> i
+            out.append(byte)
+    return out
+
+
+# Must match font.h
+FONT_BLOCK_GLYPHS = 16
+MAX_PACKED_GLYPH_BYTES = 128
+
+
+def lzss(data):
+    """LZSS as unpacked by unpackBlock() in src/font.cpp."""
+    out = bytearray()
+    heads = {}  # 3-byte prefix -> positions, oldest first
+    i = 0
+    while i < len(data):
+        flags = len(out)
+        out.append(0)
+        for bit in range(8):
+            if i >= len(data):
+                break
+            best, distance = 0, 0
+            for j in reversed(heads.get(bytes(data[i:i + 3]), [])[-64:]):
+                if i - j > 4096:
+                    break
+                n = 3
+                while n < 18 and i + n < len(data) and \
+                        data[j + n] == data[i + n]:
+                    n += 1
+                if n > best:
+                    best, distance = n, i - j
+                if n == 18:
+                    break
+            if best >= 3:
+                out[flags] |= 1 << bit
+                d = distance - 1
+                out += bytes((d & 0xFF, ((d >> 4) & 0xF0) | (best - 3)))
+                step = best
+            else:
+                out.append(data[i])
+                step = 1
+            for k in range(i, min(i + step, len(data) - 2)):
+                heads.setdefault(bytes(data[k:k + 3]), []).append(k)
+            i += step
+    return bytes(out)
+
+
+def unlzss(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        flags = data[i]
+        i += 1
+        for bit in range(8):
+            if i >= len(data):
+                break
+            if flags & (1 << bit):
+                distance = (((data[i + 1] & 0xF0) << 4) | data[i]) + 1
+                for _ in range((data[i + 1] & 0x0F) + 3):
+                    out.append(out[-distance])
+                i += 2
+            else:
+                out.append(data[i])
+                i += 1
+    return bytes(out)
+
+
+def parse_subset(spec):
+    codepoints = set()
+    for part in spec.split(','):
+        part = part.strip()
+        if not part:
+            continue
+        try:
+            first, dash, last = part.partition('-')
+            if dash:
+                codepoints.update(range(int(first, 0), int(last, 0) + 1))
+            else:
+                codepoints.add(int(first, 0))
+        except ValueError:
+            raise FontError('bad subset entry %r' % part)
+    return codepoints
+
+
+def select(src, glyphs, subset):
+    """Keep the glyphs in subset (None keeps all) plus the fallback."""
+    if src.fallback is not None and \
+            src.fallback not in [g[0] for g in glyphs]:
+        raise FontError('fallback glyph %d is not in the font' % src.fallback)
+    if subset is None:
+        return glyphs
+    keep = set(subset)
+    if src.fallback is not None:
+        keep.add(src.fallback)
+    missing = sorted(keep - set(g[0] for g in glyphs))
+    if missing:
+        sys.stderr.write('fontc: not in font: %s\n' %
+                         ' '.join('U+%04X' % cp for cp in missing))
+    return [g for g in glyphs if g[0] in keep]
+
+
+def ranges_of(codepoints):
+    ranges = []
+    for index, cp in enumerate(codepoints):
+        if ranges and ranges[-1][0] + ranges[-1][1] == cp:
+            ranges[-1][1] += 1
+        else:
+            ranges.append([cp, 1, index])
+    return ranges
+
+
+def label_comment(cp, label):
+    if 0x20 < cp < 0x7F and chr(cp) not in '\\':
+        return "'%s'" % chr(cp)
+    return 'U+%04X %s' % (cp, label)
+
+
+def emit(src, glyphs, out, name, source, columns=True, packed=False):
+    ident = name.upper()
+    bitmaps = []
+    column_bytes = []
+    blocks = []
+    entries = []
+    for index, (cp, label, width, advance, matrix, origin) in \
+            enumerate(glyphs):
+        left, top, w, h = trim(width, matrix)
+        rows = pack_rows(matrix, left, top, w, h)
+        if packed and index % FONT_BLOCK_GLYPHS == 0:
+            blocks.append(len(bitmaps))
+        offset = len(bitmaps) - (blocks[-1] if packed else 0)
+        bitmaps += rows
+        column_offset = len(column_bytes) if columns else 0
+        if columns:
+            column_bytes += pack_columns(matrix, left, top, w, h)
+        if packed and max(len(rows), w * ((h + 7) // 8)) > \
+                MAX_PACKED_GLYPH_BYTES:
+            raise FontError('U+%04X is too large for a packed font' % cp)
+        entries.append((cp, label, offset, column_offset, w, h,
+                        left + origin, top, advance))
+    if packed:
+        blocks.append(len(bitmaps))
+        packed_bytes = []
+        starts = [0]
+        for first, end in zip(blocks, blocks[1:]):
+            block = bytes(bitmaps[first:end])
+            data = lzss(block)
+            assert unlzss(data) == block
+            packed_bytes += data
+            starts.append(len(packed_bytes))
+    elif len(bitmaps) > 0xFFFF or len(column_bytes) > 0xFFFF:
+        raise FontError('glyph tables exceed 64 KiB')
+
+    codepoints = [g[0] for g in glyphs]
+    fallback = 0
+    if src.fallback is not None:
+        fallback = codepoints.index(src.fallback)
+
+    guard = 'FONTS_%s_H' % ident
+    lines = ['#ifndef %s' % guard, '#define %s' % guard, '']
+    lines.append('// Generated by tools/fontc.py from %s; do not edit.' %
+                 source)
+    if src.comments:
+        lines.append('//')
+    for c in src.comments:
+        lines.append(('// ' + c).rstrip())
+    lines.append('')
+    lines.append('#include <font.h>')
+    lines.append('')
+
+    def table(kind, data, ctype='uint8_t', per_line=12, fmt='0x%02X'):
+        lines.append('static constexpr %s %s_%s[] = {' % (ctype, ident, kind))
+        for i in range(0, len(data), per_line):
+            chunk = ', '.join(fmt % b for b in data[i:i + per_line])
+            lines.append('    %s,' % chunk)
+        lines.append('};')
+        lines.append('')
+
+    if packed:
+        lines.append('// Glyph rows, MSB-first, padded to whole bytes, '
+                     'LZSS-packed in blocks of')
+        lines.append('// FONT_BLOCK_GLYPHS glyphs')
+        table('PACKED', packed_bytes)
+        lines.append('// Start of each block in %s_PACKED, plus the end' %
+                     ident)
+        table('BLOCKS', starts, 'uint32_t', 8, '%d')
+    else:
+        lines.append('// Rows of each glyph, MSB-first, padded to whole bytes')
+        table('BITMAPS', bitmaps)
+    if columns:
+        lines.append('// Columns of each glyph, MSB-first, padded to whole '
+                     'bytes')
+        table('COLUMNS', column_bytes)
+
+    lines.append('// {offset, columns, width, height, left, top, advance}')
+    lines.append('static constexpr Glyph %s_GLYPHS[] = {' % ident)
+    for cp, label, offset, column_offset, w, h, left, top, advance in entries:
+        lines.append('    {%d, %d, %d, %d, %d, %d, %d}, // %s' %
+                     (offset, column_offset, w, h, left, top, advance,
+                      label_comment(cp, label)))
+    lines.append('};')
+    lines.append('')
+    lines.append('// {first code point, count, first glyph}')
+    lines.append('static constexpr FontRange %s_RANGES[] = {' % ident)
+    for first, count, index in ranges_of(codepoints):
+        lines.append('    {0x%04X, %d, %d},' % (first, count, index))
+    lines.append('};')
+    lines.append('')
+    lines.append('const Font %s = {' % ident)
+    if packed:
+        lines.append('    nullptr, nullptr, %s_PACKED, %s_BLOCKS,' %
+                     (ident, ident))
+    else:
+        lines.append('    %s_BITMAPS, %s, nullptr, nullptr,' %
+                     (ident, '%s_COLUMNS' % ident if columns else 'nullptr'))
+    lines.append('    %s_GLYPHS, %s_RANGES,' % (ident, ident))
+    lines.append('    sizeof(%s_RANGES) / sizeof(%s_RANGES[0]),' %
+                 (ident, ident))
+    lines.append('    %d, %d, %d};' % (src.height, src.ascent, fallback))
+    lines.append('')
+    lines.append('#endif // %s' % guard)
+    out.write('\n'.join(lines) + '\n')
+    if packed:
+        return len(packed_bytes) + 4 * len(starts) + 10 * len(entries)
+    return len(bitmaps) + len(column_bytes) + 10 * len(entries)
+
+
+def main(argv):
+    args = argv[1:]
+    subset = None
+    name = None
+    columns = True
+    packed = False
+    positional = []
+    try:
+        while args:
+            arg = args.pop(0)
+            if arg in ('--subset', '--subset-from', '--name') and not args:
+                raise FontError('%s needs a value' % arg)
+            if arg == '--subset':
+                subset = (subset or set()) | parse_subset(args.pop(0))
+            elif arg == '--subset-from':
+                with open(args.pop(0), encoding='utf-8') as f:
+                    used = set(ord(c) for c in f.read() if c not in '\r\n')
+                subset = (subset or set()) | used
+            elif arg == '--name':
+                name = args.pop(0)
+            elif arg == '--no-columns':
+                columns = False
+            elif arg == '--packed':
+                packed = True
+                columns = False
+            elif arg.startswith('--'):
+                raise FontError('unknown option %s' % arg)
+            else:
+                positional.append(arg)
+        if len(positional) != 2:
+            sys.stderr.write(__doc__)
+            return 2
+
+        source, output = positional
+        if source.endswith('.bdf'):
+            src = parse_bdf(source)
+        else:
+            src = parse(source)
+        glyphs = select(src, build(src), subset)
+        with open(output, 'w') as out:
+            size = emit(src, glyphs, out, name or src.name,
+                        source.replace(os.sep, '/'), columns, packed)
+        sys.stderr.write('fontc: %s: %d glyphs, %d bytes\n' %
+                         (output, len(glyphs), size))
+    except (FontError, IOError) as e:
+        sys.stderr.write('fontc: %s\n' % e)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))